@@ -45,7 +45,7 @@ namespace pf {
 	}
 
 	bool ColorU::is_opaque() const noexcept {
-		return a != 0;
+		return a == 255;
 	}
 
 	bool ColorU::is_fully_transparent() const noexcept {
@@ -1,5 +1,8 @@
 #include "matrix.hpp"
+#include "../simd/Simd.hpp"
+
 #include <cmath>
+#include <algorithm>
 
 namespace pf {
 	ColorMatrix::ColorMatrix() noexcept
@@ -74,6 +77,208 @@ namespace pf {
 			{ 0.2125, 0.7154, 0.0721, 0.0, 0.0 }
 		);
 	}
+
+	glm::vec4 ColorMatrix::apply(const glm::vec4& color) const noexcept {
+		const ColorMatrix& m = *this;
+		return m[0] * color.r + m[1] * color.g + m[2] * color.b + m[3] * color.a + m[4];
+	}
+
+	// The weights in 4.12 fixed point, and the offset scaled to 8 bit channels with the rounding term
+	// folded in, or nothing when a weight does not fit.
+	static constexpr int FixedPointBits = 12;
+
+	struct FixedColorMatrix {
+		std::array<std::array<int16_t, 4>, 4> columns;
+		std::array<int32_t, 4> offset;
+	};
+
+	static bool toFixedPoint(const ColorMatrix& m, FixedColorMatrix& fixed) noexcept {
+		const float one = static_cast<float>(1 << FixedPointBits);
+		for (std::size_t column = 0; column < 4; ++column) {
+			for (int channel = 0; channel < 4; ++channel) {
+				float weight = std::round(m[column][channel] * one);
+				if (!(weight >= -32768.f && weight <= 32767.f)) {
+					return false;
+				}
+				fixed.columns[column][channel] = static_cast<int16_t>(weight);
+			}
+		}
+		for (int channel = 0; channel < 4; ++channel) {
+			float offset = std::clamp(m[4][channel], -256.f, 256.f) * 255.f * one;
+			fixed.offset[channel] = static_cast<int32_t>(std::round(offset)) + (1 << (FixedPointBits - 1));
+		}
+		return true;
+	}
+
+	// Every output channel is two pairwise products, red and green then blue and alpha, which is what
+	// madd computes. Four pixels go through at a time and the packs clamp to 8 bits.
+#if defined(PF_SIMD_SSE2)
+	static std::size_t applyFixedSSE2(const FixedColorMatrix& m, ColorU* colors, std::size_t count) noexcept {
+		alignas(16) int16_t redGreen[8], blueAlpha[8];
+		for (int channel = 0; channel < 4; ++channel) {
+			redGreen[2 * channel] = m.columns[0][channel];
+			redGreen[2 * channel + 1] = m.columns[1][channel];
+			blueAlpha[2 * channel] = m.columns[2][channel];
+			blueAlpha[2 * channel + 1] = m.columns[3][channel];
+		}
+		const __m128i rg = _mm_load_si128(reinterpret_cast<const __m128i*>(redGreen));
+		const __m128i ba = _mm_load_si128(reinterpret_cast<const __m128i*>(blueAlpha));
+		const __m128i offset = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.offset.data()));
+		const __m128i zero = _mm_setzero_si128();
+
+		// Takes one pixel's red and green, and blue and alpha, each repeated over the register.
+		auto transform = [&](__m128i redGreenPairs, __m128i blueAlphaPairs) {
+			__m128i sum = _mm_add_epi32(_mm_madd_epi16(redGreenPairs, rg), _mm_madd_epi16(blueAlphaPairs, ba));
+			return _mm_srai_epi32(_mm_add_epi32(sum, offset), FixedPointBits);
+		};
+		// Two pixels widened to 16 bits.
+		auto transformPair = [&](__m128i pixels) {
+			return _mm_packs_epi32(
+				transform(_mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 1, 1, 1))),
+				transform(_mm_shuffle_epi32(pixels, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 3))));
+		};
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + i));
+			__m128i first = transformPair(_mm_unpacklo_epi8(bytes, zero));
+			__m128i second = transformPair(_mm_unpackhi_epi8(bytes, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(colors + i), _mm_packus_epi16(first, second));
+		}
+		return i;
+	}
+#elif defined(PF_SIMD_NEON)
+	static std::size_t applyFixedNEON(const FixedColorMatrix& m, ColorU* colors, std::size_t count) noexcept {
+		const int16x4_t c0 = vld1_s16(m.columns[0].data()), c1 = vld1_s16(m.columns[1].data());
+		const int16x4_t c2 = vld1_s16(m.columns[2].data()), c3 = vld1_s16(m.columns[3].data());
+		// The rounding shift below brings its own rounding term.
+		const int32x4_t offset = vsubq_s32(vld1q_s32(m.offset.data()), vdupq_n_s32(1 << (FixedPointBits - 1)));
+
+		auto transform = [&](int16x4_t pixel) {
+			int32x4_t sum = vmlal_lane_s16(offset, c0, pixel, 0);
+			sum = vmlal_lane_s16(sum, c1, pixel, 1);
+			sum = vmlal_lane_s16(sum, c2, pixel, 2);
+			sum = vmlal_lane_s16(sum, c3, pixel, 3);
+			return vqrshrun_n_s32(sum, FixedPointBits);
+		};
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			uint8_t* bytes = reinterpret_cast<uint8_t*>(colors + i);
+			uint8x16_t pixels = vld1q_u8(bytes);
+			int16x8_t low = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels)));
+			int16x8_t high = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels)));
+			uint16x8_t first = vcombine_u16(transform(vget_low_s16(low)), transform(vget_high_s16(low)));
+			uint16x8_t second = vcombine_u16(transform(vget_low_s16(high)), transform(vget_high_s16(high)));
+			vst1q_u8(bytes, vcombine_u8(vqmovn_u16(first), vqmovn_u16(second)));
+		}
+		return i;
+	}
+#endif
+
+	void ColorMatrix::apply(ColorU* colors, std::size_t count) const noexcept {
+		static_assert(sizeof(ColorU) == 4, "Colors are read as packed RGBA8");
+
+		std::size_t i = 0;
+		FixedColorMatrix fixed;
+		if (toFixedPoint(*this, fixed)) {
+			switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+			case SimdLevel::AVX2:
+			case SimdLevel::SSE2:
+				i = applyFixedSSE2(fixed, colors, count);
+				break;
+#elif defined(PF_SIMD_NEON)
+			case SimdLevel::NEON:
+				i = applyFixedNEON(fixed, colors, count);
+				break;
+#endif
+			default:
+				break;
+			}
+
+			for (; i < count; ++i) {
+				ColorU& color = colors[i];
+				const int32_t channels[4] = { color.r, color.g, color.b, color.a };
+				uint8_t result[4];
+				for (int channel = 0; channel < 4; ++channel) {
+					int32_t sum = fixed.offset[channel];
+					for (std::size_t column = 0; column < 4; ++column) {
+						sum += fixed.columns[column][channel] * channels[column];
+					}
+					result[channel] = static_cast<uint8_t>(std::clamp(sum >> FixedPointBits, 0, 255));
+				}
+				color = ColorU{ result[0], result[1], result[2], result[3] };
+			}
+			return;
+		}
+
+		for (; i < count; ++i) {
+			glm::vec4 result = glm::clamp(apply(glm::vec4{ colors[i].to_f32() }), glm::vec4{ 0.f }, glm::vec4{ 1.f }) * 255.f;
+			colors[i] = ColorU{
+				static_cast<uint8_t>(std::round(result.r)),
+				static_cast<uint8_t>(std::round(result.g)),
+				static_cast<uint8_t>(std::round(result.b)),
+				static_cast<uint8_t>(std::round(result.a)),
+			};
+		}
+	}
+
+	// One color per vector, each column scaled by one broadcast channel.
+#if defined(PF_SIMD_SSE2)
+	static std::size_t applySSE2(const ColorMatrix& m, ColorF* colors, std::size_t count) noexcept {
+		const __m128 c0 = _mm_loadu_ps(&m[0].x), c1 = _mm_loadu_ps(&m[1].x), c2 = _mm_loadu_ps(&m[2].x);
+		const __m128 c3 = _mm_loadu_ps(&m[3].x), c4 = _mm_loadu_ps(&m[4].x);
+		for (std::size_t i = 0; i < count; ++i) {
+			float* color = &colors[i].x;
+			__m128 v = _mm_loadu_ps(color);
+			__m128 sum = _mm_add_ps(c4, _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+			sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+			_mm_storeu_ps(color, sum);
+		}
+		return count;
+	}
+#elif defined(PF_SIMD_NEON)
+	static std::size_t applyNEON(const ColorMatrix& m, ColorF* colors, std::size_t count) noexcept {
+		const float32x4_t c0 = vld1q_f32(&m[0].x), c1 = vld1q_f32(&m[1].x), c2 = vld1q_f32(&m[2].x);
+		const float32x4_t c3 = vld1q_f32(&m[3].x), c4 = vld1q_f32(&m[4].x);
+		for (std::size_t i = 0; i < count; ++i) {
+			float* color = &colors[i].x;
+			float32x4_t v = vld1q_f32(color);
+			float32x4_t sum = vmlaq_laneq_f32(c4, c0, v, 0);
+			sum = vmlaq_laneq_f32(sum, c1, v, 1);
+			sum = vmlaq_laneq_f32(sum, c2, v, 2);
+			sum = vmlaq_laneq_f32(sum, c3, v, 3);
+			vst1q_f32(color, sum);
+		}
+		return count;
+	}
+#endif
+
+	void ColorMatrix::apply(ColorF* colors, std::size_t count) const noexcept {
+		std::size_t i = 0;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			i = applySSE2(*this, colors, count);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = applyNEON(*this, colors, count);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i < count; ++i) {
+			glm::vec4 result = apply(glm::vec4{ colors[i] });
+			colors[i] = ColorF{ result.r, result.g, result.b, result.a };
+		}
+	}
 }
 
 pf::ColorMatrix operator+(const pf::ColorMatrix& lh, const pf::ColorMatrix& rh) {
@@ -102,4 +307,17 @@ pf::ColorMatrix operator*(const pf::ColorMatrix& lh, float rh) {
 		lh[3] * rh,
 		lh[4] * rh
 	};
+}
+pf::ColorMatrix operator*(const pf::ColorMatrix& lh, const pf::ColorMatrix& rh) {
+	// The weights of lh apply to the columns of rh, and the offset of rh goes through lh like a color.
+	auto weigh = [&](const glm::vec4& column) {
+		return lh[0] * column.r + lh[1] * column.g + lh[2] * column.b + lh[3] * column.a;
+	};
+	return pf::ColorMatrix{
+		weigh(rh[0]),
+		weigh(rh[1]),
+		weigh(rh[2]),
+		weigh(rh[3]),
+		weigh(rh[4]) + lh[4]
+	};
 }
\ No newline at end of file
@@ -5,7 +5,11 @@
 #include <string_view>
 #include <glm/vec4.hpp>
 
+#include "color.hpp"
+
 namespace pf {
+	// Columns 0 to 3 weigh the red, green, blue and alpha inputs, column 4 is a constant offset, all in
+	// the 0 to 1 range of ColorF. The matrix works on the channels as stored, premultiplied or not.
 	struct ColorMatrix: public std::array<glm::vec4, 5> {
 		ColorMatrix(const ColorMatrix&) noexcept = default;
 		ColorMatrix& operator=(const ColorMatrix&) noexcept = default;
@@ -20,9 +24,19 @@ namespace pf {
 		static ColorMatrix saturate(float saturation) noexcept;
 
 		static ColorMatrix luminance_to_alpha() noexcept;
+
+		glm::vec4 apply(const glm::vec4& color) const noexcept;
+
+		// Transforms count colors in place. 8 bit colors are rounded and clamped, float colors are left
+		// unclamped. When every weight is within (-8, 8), 8 bit colors take a fixed point path.
+		void apply(ColorU* colors, std::size_t count) const noexcept;
+		void apply(ColorF* colors, std::size_t count) const noexcept;
 	};
 };
 
 pf::ColorMatrix operator+(const pf::ColorMatrix& lh, const pf::ColorMatrix& rh);
 pf::ColorMatrix operator-(const pf::ColorMatrix& lh, const pf::ColorMatrix& rh);
-pf::ColorMatrix operator*(const pf::ColorMatrix& lh, float rh);
\ No newline at end of file
+pf::ColorMatrix operator*(const pf::ColorMatrix& lh, float rh);
+// The matrix applying rh, then lh, so chains of filters run in one pass. Unlike separate passes, the
+// intermediate colors are not clamped.
+pf::ColorMatrix operator*(const pf::ColorMatrix& lh, const pf::ColorMatrix& rh);
\ No newline at end of file
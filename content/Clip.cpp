@@ -0,0 +1,381 @@
+#include "Clip.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include <glm/gtx/compatibility.hpp>
+
+namespace pf {
+	static constexpr uint8_t
+		OutcodeLeft = 1,
+		OutcodeRight = 2,
+		OutcodeTop = 4,
+		OutcodeBottom = 8;
+
+	static uint8_t computeOutcode(const glm::vec2& point, const RectF& rect) noexcept {
+		uint8_t outcode = 0;
+		if (point.x < rect.minX()) {
+			outcode |= OutcodeLeft;
+		}
+		if (point.y < rect.minY()) {
+			outcode |= OutcodeTop;
+		}
+		if (point.x > rect.maxX()) {
+			outcode |= OutcodeRight;
+		}
+		if (point.y > rect.maxY()) {
+			outcode |= OutcodeBottom;
+		}
+		return outcode;
+	}
+
+	std::optional<LineSegment2F> clipLineSegmentToRect(LineSegment2F segment, const RectF& rect) noexcept {
+		uint8_t outcodeFrom = computeOutcode(segment.from(), rect);
+		uint8_t outcodeTo = computeOutcode(segment.to(), rect);
+
+		while (true) {
+			if (outcodeFrom == 0 && outcodeTo == 0) {
+				return segment;
+			}
+			if ((outcodeFrom & outcodeTo) != 0) {
+				return std::nullopt;
+			}
+
+			bool clipFrom = outcodeFrom > outcodeTo;
+			uint8_t outcode = clipFrom ? outcodeFrom : outcodeTo;
+
+			glm::vec2 point;
+			if (outcode & OutcodeLeft) {
+				point = glm::vec2{ rect.minX(), segment.solveYX(rect.minX()) };
+			}
+			else if (outcode & OutcodeRight) {
+				point = glm::vec2{ rect.maxX(), segment.solveYX(rect.maxX()) };
+			}
+			else if (outcode & OutcodeTop) {
+				point = glm::vec2{ segment.solveXY(rect.minY()), rect.minY() };
+			}
+			else {
+				point = glm::vec2{ segment.solveXY(rect.maxY()), rect.maxY() };
+			}
+
+			if (clipFrom) {
+				segment.setFrom(point);
+				outcodeFrom = computeOutcode(point, rect);
+			}
+			else {
+				segment.setTo(point);
+				outcodeTo = computeOutcode(point, rect);
+			}
+		}
+	}
+
+	enum class EdgeLocation {
+		Inside,
+		Outside,
+		Intersecting,
+	};
+
+	// Interface shared by the edges below: signedDistance(point), scaled by some positive factor and
+	// not negative inside, isInside(point) and intersectLine(line), which returns the t along the line
+	// where it crosses the edge.
+
+	// A directed edge of a convex polygon, points on its left are inside.
+	struct PolygonEdge {
+		float signedDistance(const glm::vec2& point) const noexcept {
+			glm::vec2 dir = line.to() - line.from(), rel = point - line.from();
+			return dir.x * rel.y - dir.y * rel.x;
+		}
+		bool isInside(const glm::vec2& point) const noexcept {
+			return signedDistance(point) >= 0.f;
+		}
+		std::optional<float> intersectLine(const LineSegment2F& segment) const noexcept {
+			std::optional<float> t = segment.intersect(line);
+			if (t && *t >= 0.f && *t <= 1.f) {
+				return t;
+			}
+			return std::nullopt;
+		}
+
+		LineSegment2F line;
+	};
+
+	// One side of an axis-aligned rect. Crossings with lines are solved directly.
+	struct RectEdge {
+		float signedDistance(const glm::vec2& point) const noexcept {
+			return keepGreater ? point[axis] - value : value - point[axis];
+		}
+		bool isInside(const glm::vec2& point) const noexcept {
+			return signedDistance(point) >= 0.f;
+		}
+		std::optional<float> intersectLine(const LineSegment2F& segment) const noexcept {
+			float from = segment.from()[axis], to = segment.to()[axis];
+			if (from == to) {
+				return std::nullopt;
+			}
+
+			float t = (value - from) / (to - from);
+			if (t >= 0.f && t <= 1.f) {
+				return t;
+			}
+			return std::nullopt;
+		}
+
+		int axis;
+		float value;
+		bool keepGreater;
+	};
+
+	template<typename Edge>
+	static EdgeLocation testSegment(const Edge& edge, const Segment& segment) noexcept {
+		bool fromInside = edge.isInside(segment.front());
+		for (std::size_t i = 1, count = segment.size(); i < count; ++i) {
+			if (edge.isInside(segment.points[i]) != fromInside) {
+				return EdgeLocation::Intersecting;
+			}
+		}
+		return fromInside ? EdgeLocation::Inside : EdgeLocation::Outside;
+	}
+
+	// The distance of a cubic to an edge is itself a cubic Bézier over the distances of its control
+	// points. Evaluated with de Casteljau, so t = 0 and t = 1 give the end distances exactly and agree
+	// with isInside.
+	static float evaluateCubic(const std::array<float, 4>& d, float t) noexcept {
+		float d01 = d[0] + (d[1] - d[0]) * t, d12 = d[1] + (d[2] - d[1]) * t, d23 = d[2] + (d[3] - d[2]) * t;
+		float d012 = d01 + (d12 - d01) * t, d123 = d12 + (d23 - d12) * t;
+		return d012 + (d123 - d012) * t;
+	}
+
+	// Every t in [0, 1] where the sign of the distance flips, in increasing order. The zeros of the
+	// derivative cut [0, 1] into pieces where the distance is monotonic, so each piece flips at most
+	// once and is bisected on its own.
+	static std::size_t crossingsOfCubic(const std::array<float, 4>& d, std::array<float, 3>& ts) noexcept {
+		static constexpr float Precision = 1e-6f;
+
+		// The derivative is a quadratic Bézier over the differences, a * t^2 + b * t + c in power form.
+		float e0 = d[1] - d[0], e1 = d[2] - d[1], e2 = d[3] - d[2];
+		float a = e0 - 2.f * e1 + e2, b = 2.f * (e1 - e0), c = e0;
+
+		std::array<float, 4> bounds;
+		std::size_t boundCount = 0;
+		bounds[boundCount++] = 0.f;
+		auto addBound = [&](float t) {
+			if (t > 0.f && t < 1.f) {
+				bounds[boundCount++] = t;
+			}
+		};
+		if (std::abs(a) <= 1e-7f * (std::abs(b) + std::abs(c))) {
+			if (b != 0.f) {
+				addBound(-c / b);
+			}
+		}
+		else {
+			float discriminant = b * b - 4.f * a * c;
+			if (discriminant >= 0.f) {
+				float q = -0.5f * (b + std::copysign(std::sqrt(discriminant), b));
+				float t0 = q / a, t1 = q != 0.f ? c / q : t0;
+				addBound(std::min(t0, t1));
+				if (t1 != t0) {
+					addBound(std::max(t0, t1));
+				}
+			}
+		}
+		bounds[boundCount++] = 1.f;
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i + 1 < boundCount; ++i) {
+			float lo = bounds[i], hi = bounds[i + 1];
+			bool insideLo = evaluateCubic(d, lo) >= 0.f;
+			if (insideLo == (evaluateCubic(d, hi) >= 0.f)) {
+				continue;
+			}
+
+			while (hi - lo > Precision) {
+				float mid = 0.5f * (lo + hi);
+				if ((evaluateCubic(d, mid) >= 0.f) == insideLo) {
+					lo = mid;
+				}
+				else {
+					hi = mid;
+				}
+			}
+			ts[count++] = 0.5f * (lo + hi);
+		}
+		return count;
+	}
+
+	template<typename Edge>
+	static std::size_t intersectSegment(const Edge& edge, const Segment& segment, std::array<float, 3>& ts) noexcept {
+		if (segment.isLine()) {
+			std::optional<float> t = edge.intersectLine(LineSegment2F{ segment.front(), segment.back() });
+			if (t) {
+				ts[0] = *t;
+				return 1;
+			}
+			return 0;
+		}
+
+		Segment cubic = segment.toCubic();
+		std::array<float, 4> distances;
+		for (std::size_t i = 0; i < distances.size(); ++i) {
+			distances[i] = edge.signedDistance(cubic.points[i]);
+		}
+		return crossingsOfCubic(distances, ts);
+	}
+
+	static void pushClippedSegment(Contour& contour, const Segment& segment) {
+		// Consecutive pieces that do not meet are joined along the edge they were clipped by.
+		bool includeFrom = contour.empty() || contour.back().point != segment.front();
+		contour.pushSegment(segment, true, includeFrom);
+	}
+
+	template<typename Edge>
+	static void clipSegmentAgainst(Contour& output, Segment segment, const Edge& edge) {
+		switch (testSegment(edge, segment)) {
+		case EdgeLocation::Outside:
+			return;
+		case EdgeLocation::Inside:
+			pushClippedSegment(output, segment);
+			return;
+		default:
+			break;
+		}
+
+		bool inside = edge.isInside(segment.front());
+		std::array<float, 3> ts;
+		std::size_t count = intersectSegment(edge, segment, ts);
+
+		float lastT = 0.f;
+		for (std::size_t i = 0; i < count; ++i) {
+			std::array<Segment, 2> halves = segment.split((ts[i] - lastT) / (1.f - lastT));
+			if (inside) {
+				pushClippedSegment(output, halves[0]);
+			}
+
+			inside = !inside;
+			lastT = ts[i];
+			segment = halves[1];
+		}
+
+		if (inside) {
+			pushClippedSegment(output, segment);
+		}
+	}
+
+	// Clips contour against one edge, using scratch as the destination and swapping the two at the end.
+	template<typename Edge>
+	static void clipContourAgainst(Contour& contour, Contour& scratch, const Edge& edge) {
+		// Skip the rebuild when every segment is on the same side of the edge.
+		std::optional<EdgeLocation> location;
+		for (ContourIter iter = contour.iter(); !iter.done();) {
+			EdgeLocation next = testSegment(edge, iter.next());
+			if (!location) {
+				location = next;
+			}
+			if (next == EdgeLocation::Intersecting || next != *location) {
+				location = EdgeLocation::Intersecting;
+				break;
+			}
+		}
+
+		if (location == EdgeLocation::Inside) {
+			return;
+		}
+		if (!location || location == EdgeLocation::Outside) {
+			contour.clear();
+			return;
+		}
+
+		scratch.clear();
+		for (ContourIter iter = contour.iter(); !iter.done();) {
+			clipSegmentAgainst(scratch, iter.next(), edge);
+		}
+		if (contour.isClosed()) {
+			scratch.close();
+		}
+		std::swap(contour, scratch);
+	}
+
+	bool rectIsOutsidePolygon(const RectF& rect, const std::vector<glm::vec2>& polygon) noexcept {
+		uint8_t outcode = OutcodeLeft | OutcodeRight | OutcodeTop | OutcodeBottom;
+		for (const glm::vec2& point : polygon) {
+			if (point.x > rect.minX()) {
+				outcode &= ~OutcodeLeft;
+			}
+			if (point.x < rect.maxX()) {
+				outcode &= ~OutcodeRight;
+			}
+			if (point.y > rect.minY()) {
+				outcode &= ~OutcodeTop;
+			}
+			if (point.y < rect.maxY()) {
+				outcode &= ~OutcodeBottom;
+			}
+		}
+		if (outcode != 0) {
+			return true;
+		}
+
+		// Separating axis test against each polygon edge.
+		const glm::vec2 corners[4] = { rect.upperLeft(), rect.upperRight(), rect.lowerLeft(), rect.lowerRight() };
+		for (std::size_t i = 0, count = polygon.size(); i < count; ++i) {
+			PolygonEdge edge{ LineSegment2F{ polygon[i == 0 ? count - 1 : i - 1], polygon[i] } };
+			if (std::none_of(std::begin(corners), std::end(corners), [&](const glm::vec2& p) { return edge.isInside(p); })) {
+				return true;
+			}
+		}
+		return false;
+	}
+	bool rectIsInsidePolygon(const RectF& rect, const std::vector<glm::vec2>& polygon) noexcept {
+		const glm::vec2 corners[4] = { rect.upperLeft(), rect.upperRight(), rect.lowerLeft(), rect.lowerRight() };
+		for (std::size_t i = 0, count = polygon.size(); i < count; ++i) {
+			PolygonEdge edge{ LineSegment2F{ polygon[i == 0 ? count - 1 : i - 1], polygon[i] } };
+			if (!std::all_of(std::begin(corners), std::end(corners), [&](const glm::vec2& p) { return edge.isInside(p); })) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Contour clipContourToPolygon(const Contour& contour, const std::vector<glm::vec2>& polygon) {
+		if (polygon.empty()) {
+			return Contour{};
+		}
+
+		Contour result = contour, scratch;
+		glm::vec2 prev = polygon.back();
+		for (const glm::vec2& next : polygon) {
+			clipContourAgainst(result, scratch, PolygonEdge{ LineSegment2F{ prev, next } });
+			if (result.empty()) {
+				break;
+			}
+			prev = next;
+		}
+		return result;
+	}
+
+	Contour clipContourToRect(const Contour& contour, const RectF& rect) {
+		if (rect.contains(contour.bounds)) {
+			return contour;
+		}
+		if (contour.bounds.maxX() < rect.minX() || contour.bounds.minX() > rect.maxX() ||
+			contour.bounds.maxY() < rect.minY() || contour.bounds.minY() > rect.maxY()) {
+			return Contour{};
+		}
+
+		const RectEdge edges[4] = {
+			RectEdge{ 0, rect.minX(), true },
+			RectEdge{ 1, rect.minY(), true },
+			RectEdge{ 0, rect.maxX(), false },
+			RectEdge{ 1, rect.maxY(), false },
+		};
+
+		Contour result = contour, scratch;
+		for (const RectEdge& edge : edges) {
+			clipContourAgainst(result, scratch, edge);
+			if (result.empty()) {
+				break;
+			}
+		}
+		return result;
+	}
+};
\ No newline at end of file
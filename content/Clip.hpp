@@ -1,8 +1,23 @@
 #pragma once
+#include <optional>
+#include <vector>
+
 #include "Outline.hpp"
 #include "Segment.hpp"
 #include "../geometry/LineSegment.hpp"
+#include "../geometry/Rect.hpp"
 
 namespace pf {
+	// Clips a line segment to an axis-aligned rectangle using Cohen-Sutherland clipping.
+	std::optional<LineSegment2F> clipLineSegmentToRect(LineSegment2F segment, const RectF& rect) noexcept;
+
+	// Quick tests of a rect against a convex polygon. Both may answer false for borderline cases.
+	bool rectIsOutsidePolygon(const RectF& rect, const std::vector<glm::vec2>& polygon) noexcept;
+	bool rectIsInsidePolygon(const RectF& rect, const std::vector<glm::vec2>& polygon) noexcept;
 
+	// Sutherland-Hodgman clipping of a contour against a convex polygon, or an axis-aligned rect.
+	// Curves are split where they cross an edge rather than flattened, and the pieces left on
+	// the inside are joined with lines along the edge, which is what filling needs.
+	Contour clipContourToPolygon(const Contour& contour, const std::vector<glm::vec2>& polygon);
+	Contour clipContourToRect(const Contour& contour, const RectF& rect);
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Contour.hpp"
+#include "Dilation.hpp"
 #include "Util.hpp"
+#include "../geometry/Util.hpp"
 
 #include <cassert>
 #include <limits>
@@ -137,6 +139,14 @@ namespace pf {
 		return points[index];
 	}
 
+	bool Contour::isEndpoint(std::size_t index) const noexcept {
+		return points[index].kind == 0;
+	}
+
+	ContourIter Contour::iter(ContourIterFlags flags) const noexcept {
+		return ContourIter{ *this, flags };
+	}
+
 	void Contour::pushPoint(const glm::vec2& p, int kind, bool updateBounds) {
 		if (updateBounds) {
 			if (empty()) {
@@ -148,18 +158,19 @@ namespace pf {
 		}
 		points.push_back(Point{ p, kind });
 	}
-	void Contour::pushSegment(const Segment& seg, bool updateBounds) {
+	void Contour::pushSegment(const Segment& seg, bool updateBounds, bool includeFromPoint) {
 		if (seg.isNone()) {
 			return;
 		}
 
-		int kind = 0;
-		auto it = seg.begin();
-		for (auto last = seg.end() - 1; it != last; ++it) {
-			pushPoint(*it, kind, updateBounds);
-			++kind;
+		std::size_t count = seg.size();
+		if (includeFromPoint) {
+			pushPoint(seg.points[0], 0, updateBounds);
+		}
+		for (std::size_t i = 1; i + 1 < count; ++i) {
+			pushPoint(seg.points[i], static_cast<int>(i), updateBounds);
 		}
-		pushPoint(*it, 0, updateBounds);
+		pushPoint(seg.points[count - 1], 0, updateBounds);
 	}
 	void Contour::pushEllipse(const Transform2F& form) {
 		Segment segment = Segment::quarterArc();
@@ -167,13 +178,13 @@ namespace pf {
 		pushSegment(segment.transform(form), true);
 
 		rotation = Transform2F::fromRotation(glm::vec2{ 0.f, 1.f });
-		pushSegment(segment.transform(form.apply(rotation)), true);
+		pushSegment(segment.transform(form.apply(rotation)), true, false);
 
 		rotation = Transform2F::fromRotation(glm::vec2{ -1.f, 0.f });
-		pushSegment(segment.transform(form.apply(rotation)), true);
+		pushSegment(segment.transform(form.apply(rotation)), true, false);
 
 		rotation = Transform2F::fromRotation(glm::vec2{ 0.f, -1.f });
-		pushSegment(segment.transform(form.apply(rotation)), true);
+		pushSegment(segment.transform(form.apply(rotation)), true, false);
 	}
 	void Contour::pushArc(const Transform2F& form, float s, float e, ArcDirection dir) {
 		if ((e - s) >= tau) {
@@ -197,7 +208,7 @@ namespace pf {
 
 		for (int i = 0; i < 4; ++i) {
 			glm::vec2 sweep = revRotateBy(endNorm, norm);
-			bool last = std::abs(sweep.x) < 1e-3f;
+			bool last = sweep.x >= -Eps && sweep.y >= -Eps;
 
 			Segment segment;
 			if (!last) {
@@ -213,7 +224,7 @@ namespace pf {
 
 			segment = segment.transform(form.apply(dirForm).apply(rotation));
 
-			pushSegment(segment, true);
+			pushSegment(segment, true, i == 0);
 			if (last) {
 				break;
 			}
@@ -298,8 +309,8 @@ namespace pf {
 			return;
 		}
 
-		for (Point & point : points) {
-			point.point = form.apply(point.point);
+		if (!points.empty()) {
+			bounds = form.applyBatchBounds(&points[0].point, &points[0].point, points.size(), sizeof(Point));
 		}
 	}
 	Contour Contour::transformed(const Transform2F& form) const {
@@ -308,6 +319,15 @@ namespace pf {
 		return copy;
 	}
 
+	float Contour::signedArea() const noexcept {
+		return pf::signedArea(*this);
+	}
+
+	void Contour::dilate(const glm::vec2& amount, Orientation orientation) {
+		ContourDilator{ *this, amount, orientation }.dilate();
+		bounds = bounds.dilate(amount);
+	}
+
 	Contour::iterator Contour::begin() noexcept {
 		return points.begin();
 	}
@@ -349,4 +369,51 @@ namespace pf {
 	Contour::const_reverse_iterator Contour::crend() const noexcept {
 		return points.crend();
 	}
+
+	ContourIter::ContourIter(const Contour& _contour, ContourIterFlags _flags) noexcept
+		: ContourIter(_contour.points.data(), _contour.size(), _contour.isClosed(), _flags)
+	{}
+	ContourIter::ContourIter(const Contour::Point* _points, std::size_t _count, bool _closed, ContourIterFlags _flags) noexcept
+		: points(_points)
+		, count(_count)
+		, index(1)
+		, closed(_closed)
+		, flags(_flags)
+	{}
+
+	bool ContourIter::done() const noexcept {
+		bool includeClose = closed &&
+			(static_cast<uint8_t>(flags) & static_cast<uint8_t>(ContourIterFlags::IgnoreCloseSegment)) == 0;
+		return count == 0 || (index == count && !includeClose) || index > count;
+	}
+
+	Segment ContourIter::next() noexcept {
+		if (done()) {
+			return Segment::none();
+		}
+
+		glm::vec2 p0 = points[index - 1].point;
+		if (index == count) {
+			++index;
+			return Segment::line(p0, points[0].point);
+		}
+
+		glm::vec2 p1 = points[index].point;
+		++index;
+		if (points[index - 1].kind == 0) {
+			return Segment::line(p0, p1);
+		}
+
+		// Control points are always followed by another point, so the lookups below stay in range.
+		glm::vec2 p2 = points[index].point;
+		++index;
+		if (points[index - 1].kind == 0) {
+			return Segment::quadratic(p0, p1, p2);
+		}
+
+		glm::vec2 p3 = points[index].point;
+		++index;
+		assert(points[index - 1].kind == 0);
+		return Segment::cubic(p0, p1, p2, p3);
+	}
 };
\ No newline at end of file
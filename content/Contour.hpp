@@ -8,6 +8,7 @@
 #include "../geometry/Transform2d.hpp"
 
 #include "Segment.hpp"
+#include "Orientation.hpp"
 
 namespace pf {
 	enum class ArcDirection {
@@ -17,6 +18,14 @@ namespace pf {
 		CCW,
 	};
 
+	enum class ContourIterFlags : uint8_t {
+		None = 0,
+		/// Skip the implicit segment that joins the last point to the first one on closed contours.
+		IgnoreCloseSegment = 1,
+	};
+
+	struct ContourIter;
+
 	struct Contour {
 		struct Point {
 			glm::vec2 point;
@@ -58,8 +67,13 @@ namespace pf {
 		Point& operator[](std::size_t index);
 		const Point& operator[](std::size_t index) const;
 
+		bool isEndpoint(std::size_t index) const noexcept;
+
+		ContourIter iter(ContourIterFlags flags = ContourIterFlags::None) const noexcept;
+
 		void pushPoint(const glm::vec2& p, int kind, bool updateBounds);
-		void pushSegment(const Segment& seg, bool updateBounds);
+		// Leave out the first point when it is already the last point of the contour.
+		void pushSegment(const Segment& seg, bool updateBounds, bool includeFromPoint = true);
 		void pushEllipse(const Transform2F& form);
 		void pushArc(const Transform2F& form, float s, float e, ArcDirection dir);
 		void pushArcFromUnitChord(const Transform2F& form, LineSegment2F chord, ArcDirection dir);
@@ -73,6 +87,12 @@ namespace pf {
 		void transform(const Transform2F& form);
 		Contour transformed(const Transform2F& form) const;
 
+		// See signedArea in Orientation.hpp.
+		float signedArea() const noexcept;
+
+		// Moves the points outward in place, see ContourDilator.
+		void dilate(const glm::vec2& amount, Orientation orientation);
+
 		iterator begin() noexcept;
 		iterator end() noexcept;
 
@@ -95,4 +115,21 @@ namespace pf {
 		RectF bounds;
 		bool closed;
 	};
+
+	// Walks the segments of a contour, following the control point kinds stored with each point.
+	struct ContourIter {
+		ContourIter(const Contour& _contour, ContourIterFlags _flags) noexcept;
+		ContourIter(const Contour::Point* _points, std::size_t _count, bool _closed, ContourIterFlags _flags) noexcept;
+
+		bool done() const noexcept;
+
+		// Returns Segment::none() once the contour is exhausted.
+		Segment next() noexcept;
+	private:
+		const Contour::Point* points;
+		std::size_t count;
+		std::size_t index;
+		bool closed;
+		ContourIterFlags flags;
+	};
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "ContourSoA.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace pf {
+	ContourSoA ContourSoA::withCapacity(std::size_t cap) {
+		ContourSoA ret;
+		ret.reserve(cap);
+		return ret;
+	}
+	ContourSoA ContourSoA::fromContour(const Contour& contour) {
+		ContourSoA ret;
+		std::size_t count = contour.size();
+		ret.xs.resize(count);
+		ret.ys.resize(count);
+		ret.kinds.resize(count);
+
+		float* xs = ret.xs.data();
+		float* ys = ret.ys.data();
+		uint8_t* kinds = ret.kinds.data();
+		const Contour::Point* points = contour.points.data();
+		for (std::size_t i = 0; i < count; ++i) {
+			xs[i] = points[i].point.x;
+			ys[i] = points[i].point.y;
+			kinds[i] = static_cast<uint8_t>(points[i].kind);
+		}
+
+		ret.bounds = contour.bounds;
+		ret.closed = contour.closed;
+		return ret;
+	}
+
+	ContourSoA::ContourSoA()
+		: bounds{}
+		, closed(false)
+	{}
+
+	Contour ContourSoA::toContour() const {
+		Contour ret;
+		std::size_t count = size();
+		ret.points.resize(count);
+
+		Contour::Point* points = ret.points.data();
+		for (std::size_t i = 0; i < count; ++i) {
+			points[i].point = glm::vec2{ xs[i], ys[i] };
+			points[i].kind = kinds[i];
+		}
+
+		ret.bounds = bounds;
+		ret.closed = closed;
+		return ret;
+	}
+
+	void ContourSoA::clear() noexcept {
+		xs.clear();
+		ys.clear();
+		kinds.clear();
+		bounds = RectF{};
+		closed = false;
+	}
+	bool ContourSoA::empty() const noexcept {
+		return kinds.empty();
+	}
+	bool ContourSoA::isClosed() const noexcept {
+		return closed;
+	}
+	std::size_t ContourSoA::size() const noexcept {
+		return kinds.size();
+	}
+	void ContourSoA::reserve(std::size_t cap) {
+		xs.reserve(cap);
+		ys.reserve(cap);
+		kinds.reserve(cap);
+	}
+
+	void ContourSoA::close() {
+		closed = true;
+	}
+
+	glm::vec2 ContourSoA::position(std::size_t index) const {
+		assert(index < size());
+		return glm::vec2{ xs[index], ys[index] };
+	}
+	uint8_t ContourSoA::kind(std::size_t index) const {
+		assert(index < size());
+		return kinds[index];
+	}
+	bool ContourSoA::isEndpoint(std::size_t index) const {
+		return kind(index) == 0;
+	}
+
+	void ContourSoA::pushPoint(const glm::vec2& p, uint8_t kind) {
+		if (empty()) {
+			bounds = RectF::fromPoints(p, p);
+		}
+		else {
+			bounds = bounds.merge(p);
+		}
+		xs.push_back(p.x);
+		ys.push_back(p.y);
+		kinds.push_back(kind);
+	}
+
+	void ContourSoA::transform(const Transform2F& form) {
+		if (form.isIdentity()) {
+			return;
+		}
+
+		bounds = form.applyBatchBounds(xs.data(), ys.data(), xs.data(), ys.data(), size());
+	}
+	ContourSoA ContourSoA::transformed(const Transform2F& form) const {
+		ContourSoA copy = *this;
+		copy.transform(form);
+		return copy;
+	}
+
+	void ContourSoA::recalculateBounds() noexcept {
+		if (empty()) {
+			bounds = RectF{};
+			return;
+		}
+
+		float minX = xs[0], minY = ys[0], maxX = xs[0], maxY = ys[0];
+		for (std::size_t i = 1, count = size(); i < count; ++i) {
+			minX = std::min(minX, xs[i]);
+			maxX = std::max(maxX, xs[i]);
+			minY = std::min(minY, ys[i]);
+			maxY = std::max(maxY, ys[i]);
+		}
+		bounds = RectF::fromPoints(glm::vec2{ minX, minY }, glm::vec2{ maxX, maxY });
+	}
+};
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include "../geometry/Rect.hpp"
+#include "../geometry/Transform2d.hpp"
+
+#include "Contour.hpp"
+
+namespace pf {
+	// Structure of arrays storage for the points of a Contour. Coordinates and point kinds live in
+	// separate arrays, so transforms and bounds run as straight loops over floats.
+	struct ContourSoA {
+		static ContourSoA withCapacity(std::size_t cap);
+		static ContourSoA fromContour(const Contour& contour);
+
+		ContourSoA(const ContourSoA&) = default;
+		ContourSoA(ContourSoA&&) noexcept = default;
+		ContourSoA& operator=(const ContourSoA&) = default;
+		ContourSoA& operator=(ContourSoA&&) noexcept = default;
+		~ContourSoA() = default;
+
+		ContourSoA();
+
+		Contour toContour() const;
+
+		void clear() noexcept;
+		bool empty() const noexcept;
+		bool isClosed() const noexcept;
+		std::size_t size() const noexcept;
+		void reserve(std::size_t cap);
+
+		void close();
+
+		glm::vec2 position(std::size_t index) const;
+		uint8_t kind(std::size_t index) const;
+		bool isEndpoint(std::size_t index) const;
+
+		void pushPoint(const glm::vec2& p, uint8_t kind);
+
+		void transform(const Transform2F& form);
+		ContourSoA transformed(const Transform2F& form) const;
+
+		// Recomputes bounds from the points.
+		void recalculateBounds() noexcept;
+
+		std::vector<float> xs, ys;
+		std::vector<uint8_t> kinds;
+		RectF bounds;
+		bool closed;
+	};
+};
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "Dash.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace pf {
+	static constexpr float DashEps = 1e-4f;
+
+	// Curves are measured along a polyline within this distance of the curve.
+	static constexpr float ArcLengthTolerance = 0.05f;
+	static constexpr std::size_t MaxArcLengthSamples = 64;
+
+	void ArcLengthTable::build(const Segment& segment) {
+		std::size_t count = segment.isLine() ? 1 : std::min(std::max(segment.flattenCount(ArcLengthTolerance), std::size_t(1)), MaxArcLengthSamples);
+
+		lengths.resize(count + 1);
+		lengths[0] = 0.f;
+
+		glm::vec2 prev = segment.front();
+		float step = 1.f / static_cast<float>(count);
+		for (std::size_t i = 1; i <= count; ++i) {
+			glm::vec2 next = i == count ? segment.back() : segment.sample(static_cast<float>(i) * step);
+			lengths[i] = lengths[i - 1] + glm::length(next - prev);
+			prev = next;
+		}
+	}
+
+	float ArcLengthTable::length() const noexcept {
+		return lengths.back();
+	}
+
+	float ArcLengthTable::timeForDistance(float distance) const noexcept {
+		if (distance <= 0.f) {
+			return 0.f;
+		}
+		if (distance >= length()) {
+			return 1.f;
+		}
+
+		std::size_t index = std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin();
+		float before = lengths[index - 1], after = lengths[index];
+		float frac = after > before ? (distance - before) / (after - before) : 0.f;
+		return (static_cast<float>(index - 1) + frac) / static_cast<float>(lengths.size() - 1);
+	}
+
+	// The part of a segment between t0 and t1.
+	static Segment subsegment(const Segment& segment, float t0, float t1) noexcept {
+		Segment rest = t0 > 0.f ? segment.splitAfter(t0) : segment;
+		if (t1 >= 1.f) {
+			return rest;
+		}
+		return rest.splitBefore((t1 - t0) / (1.f - t0));
+	}
+
+	DashState::DashState(const std::vector<float>& _dashes, float _offset)
+		: dashes(_dashes)
+		, offset(_offset)
+		, currentIndex(0)
+		, distanceLeft(0.f)
+	{
+		if (dashes.size() % 2 == 1) {
+			dashes.insert(dashes.end(), _dashes.begin(), _dashes.end());
+		}
+		reset();
+	}
+
+	void DashState::reset() noexcept {
+		output.clear();
+		currentIndex = 0;
+		distanceLeft = 0.f;
+		if (isSolid()) {
+			return;
+		}
+
+		float total = 0.f;
+		for (float dash : dashes) {
+			total += dash;
+		}
+
+		float phase = std::fmod(offset, total);
+		if (phase < 0.f) {
+			phase += total;
+		}
+
+		while (phase >= dashes[currentIndex]) {
+			phase -= dashes[currentIndex];
+			currentIndex = (currentIndex + 1) % dashes.size();
+		}
+		distanceLeft = dashes[currentIndex] - phase;
+	}
+
+	void DashState::advance() noexcept {
+		currentIndex = (currentIndex + 1) % dashes.size();
+		distanceLeft = dashes[currentIndex];
+	}
+
+	bool DashState::isOn() const noexcept {
+		return currentIndex % 2 == 0;
+	}
+	bool DashState::isSolid() const noexcept {
+		for (float dash : dashes) {
+			if (dash < 0.f || !std::isfinite(dash)) {
+				return true;
+			}
+		}
+		return std::none_of(dashes.begin(), dashes.end(), [](float dash) { return dash > 0.f; });
+	}
+
+	ContourDash::ContourDash(const Contour& _input, DashState& _state)
+		: input(&_input)
+		, state(&_state)
+	{}
+
+	void ContourDash::dash(const DashSink& sink) {
+		DashState& st = *state;
+		st.reset();
+
+		if (st.isSolid()) {
+			if (!input->empty()) {
+				sink(*input);
+			}
+			return;
+		}
+
+		ArcLengthTable& table = st.table;
+
+		for (ContourIter iter = input->iter(); !iter.done();) {
+			Segment segment = iter.next();
+			table.build(segment);
+
+			float length = table.length();
+			float position = 0.f;
+			float t = 0.f;
+
+			while (length - position >= st.distanceLeft) {
+				position += st.distanceLeft;
+				float next = table.timeForDistance(position);
+
+				if (st.isOn()) {
+					st.output.pushSegment(subsegment(segment, t, next), true, st.output.empty());
+					sink(st.output);
+					st.output.clear();
+				}
+
+				t = next;
+				st.advance();
+			}
+
+			st.distanceLeft -= length - position;
+			if (st.isOn() && t < 1.f) {
+				st.output.pushSegment(subsegment(segment, t, 1.f), true, st.output.empty());
+			}
+			if (st.distanceLeft < DashEps) {
+				if (st.isOn() && !st.output.empty()) {
+					sink(st.output);
+					st.output.clear();
+				}
+				st.advance();
+			}
+		}
+
+		if (!st.output.empty()) {
+			sink(st.output);
+			st.output.clear();
+		}
+	}
+
+	Dash::Dash(const Outline& _input, const std::vector<float>& dashes, float offset)
+		: input(&_input)
+		, state(dashes, offset)
+	{}
+
+	void Dash::dash(const DashSink& sink) {
+		for (const Contour& contour : *input) {
+			ContourDash{ contour, state }.dash(sink);
+		}
+	}
+
+	OutlineDash::OutlineDash(const Outline& _input, const std::vector<float>& dashes, float offset)
+		: input(&_input)
+		, state(dashes, offset)
+	{}
+
+	void OutlineDash::dash() {
+		output.clear();
+		for (const Contour& contour : *input) {
+			ContourDash{ contour, state }.dash([this](const Contour& dash) {
+				output.push(dash);
+			});
+		}
+	}
+
+	Outline OutlineDash::intoOutline() {
+		return std::move(output);
+	}
+};
\ No newline at end of file
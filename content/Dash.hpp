@@ -1,30 +1,81 @@
 #pragma once
+#include <vector>
+#include <functional>
+
 #include "Outline.hpp"
 
 namespace pf {
+	// Receives each finished dash. The contour is reused for the next dash, so copy it to keep it.
+	using DashSink = std::function<void(const Contour&)>;
+
+	// Cumulative arc length of a segment at evenly spaced t. Distances are mapped back to t by
+	// interpolating between neighbouring samples.
+	struct ArcLengthTable {
+		void build(const Segment& segment);
+
+		float length() const noexcept;
+		float timeForDistance(float distance) const noexcept;
+
+		std::vector<float> lengths;
+	};
+
+	// Position within a dash pattern, see CanvasRenderingContext2D.setLineDash and lineDashOffset.
 	struct DashState {
+		// An odd number of dashes is repeated once, as canvas does. A pattern without any positive
+		// length turns dashing off, and contours pass through whole.
+		DashState(const std::vector<float>& _dashes, float _offset);
 
+		// Moves back to the start of the pattern, shifted by the offset.
+		void reset() noexcept;
+		// Moves on to the next dash or gap.
+		void advance() noexcept;
 
 		bool isOn() const noexcept;
+		bool isSolid() const noexcept;
+
+		std::vector<float> dashes;
+		float offset;
 
 		Contour output;
 		std::size_t currentIndex;
 		float distanceLeft;
+		// The segment being dashed. Kept across segments, so it only allocates until it has grown to
+		// its largest size.
+		ArcLengthTable table;
 	};
 
-	struct Dash {
-		Outline output;
+	// Dashes a single contour, walking each segment once. The pattern restarts at the beginning
+	// of the contour, and a dash still open at its end is passed to the sink as well.
+	struct ContourDash {
+		ContourDash(const Contour& _input, DashState& _state);
+
+		void dash(const DashSink& sink);
 
+		const Contour* input;
+		DashState* state;
 	};
 
-	struct OutlineDash {
-		Outline output;
+	// Streams the dashes of an outline to a sink, without storing more than the dash being built.
+	struct Dash {
+		Dash(const Outline& _input, const std::vector<float>& dashes, float offset);
+
+		void dash(const DashSink& sink);
+
+		const Outline* input;
 		DashState state;
 	};
 
-	struct ContourDash {
+	// Dashes an outline into a new outline. The stroke should be dashed before it is converted to a fill.
+	struct OutlineDash {
+		OutlineDash(const Outline& _input, const std::vector<float>& dashes, float offset);
 
-	};
+		void dash();
+
+		// Returns the dashed outline, call after dash.
+		Outline intoOutline();
 
-	
+		const Outline* input;
+		Outline output;
+		DashState state;
+	};
 };
\ No newline at end of file
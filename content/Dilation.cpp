@@ -0,0 +1,88 @@
+#include "Dilation.hpp"
+#include "Contour.hpp"
+
+#include <cmath>
+
+namespace pf {
+	static glm::vec2 normalizeOrZero(const glm::vec2& v) noexcept {
+		float length = std::sqrt(v.x * v.x + v.y * v.y);
+		return length == 0.f ? glm::vec2{ 0.f } : v * (1.f / length);
+	}
+
+	ContourDilator::ContourDilator(Contour& _contour, const glm::vec2& _amount, Orientation _orientation) noexcept
+		: contour(&_contour)
+		, amount(_amount)
+		, orientation(_orientation)
+	{}
+
+	void ContourDilator::dilate() noexcept {
+		Contour::Point* points = contour->points.data();
+		const std::size_t count = contour->size();
+		if (count == 0) {
+			return;
+		}
+
+		auto nextIndex = [count](std::size_t index) {
+			return index + 1 == count ? 0 : index + 1;
+		};
+		auto prevIndex = [count](std::size_t index) {
+			return index == 0 ? count - 1 : index - 1;
+		};
+
+		// Counterclockwise contours move out along (y, -x), clockwise ones along (-y, x).
+		const float sign = static_cast<float>(orientation);
+		const glm::vec2 scale = amount * glm::vec2{ -sign, sign };
+
+		// Find the last point that differs from the first one, runs of duplicates are moved together.
+		const glm::vec2 firstPosition = points[0].point;
+		std::size_t prevPointIndex = 0;
+		glm::vec2 prevPosition;
+		do {
+			prevPointIndex = prevIndex(prevPointIndex);
+			prevPosition = points[prevPointIndex].point;
+		} while (prevPointIndex != 0 && prevPosition == firstPosition);
+
+		const std::size_t firstPointIndex = nextIndex(prevPointIndex);
+		std::size_t currentPointIndex = firstPointIndex;
+		glm::vec2 position = firstPosition;
+		glm::vec2 prevVector = normalizeOrZero(position - prevPosition);
+
+		// Points ahead of the current one are still untouched, so everything can be read and
+		// written through the same buffer.
+		while (true) {
+			std::size_t nextPointIndex = currentPointIndex;
+			glm::vec2 nextPosition;
+			while (true) {
+				nextPointIndex = nextIndex(nextPointIndex);
+				if (nextPointIndex == firstPointIndex) {
+					nextPosition = firstPosition;
+					break;
+				}
+				nextPosition = points[nextPointIndex].point;
+				if (nextPointIndex == currentPointIndex || nextPosition != position) {
+					break;
+				}
+			}
+			glm::vec2 nextVector = normalizeOrZero(nextPosition - position);
+
+			glm::vec2 bisector{ prevVector.y + nextVector.y, prevVector.x + nextVector.x };
+			float bisectorLength = std::sqrt(bisector.x * bisector.x + bisector.y * bisector.y);
+			glm::vec2 newPosition = position;
+			if (bisectorLength != 0.f) {
+				newPosition -= bisector * scale * (1.f / bisectorLength);
+			}
+
+			for (std::size_t i = currentPointIndex; i != nextPointIndex; i = nextIndex(i)) {
+				points[i].point = newPosition;
+			}
+
+			if (nextPointIndex == firstPointIndex) {
+				break;
+			}
+
+			prevVector = nextVector;
+			position = nextPosition;
+			currentPointIndex = nextPointIndex;
+		}
+	}
+};
\ No newline at end of file
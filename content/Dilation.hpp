@@ -1,5 +1,20 @@
 #pragma once
+#include <glm/vec2.hpp>
+
+#include "Orientation.hpp"
 
 namespace pf {
+	struct Contour;
+
+	// Pushes every point of a contour outward along the bisector of its two neighboring edges,
+	// the points are updated in place. Amount can differ per axis, which is what stem darkening needs.
+	struct ContourDilator {
+		ContourDilator(Contour& _contour, const glm::vec2& _amount, Orientation _orientation) noexcept;
+
+		void dilate() noexcept;
 
+		Contour* contour;
+		glm::vec2 amount;
+		Orientation orientation;
+	};
 };
\ No newline at end of file
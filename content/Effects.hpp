@@ -87,7 +87,7 @@ namespace pf {
         Default = SrcOver,
     };
 
-    bool occludesBackdrop(BlendMode mode) noexcept {
+    inline bool occludesBackdrop(BlendMode mode) noexcept {
         switch (mode) {
         case BlendMode::SrcOver:
         case BlendMode::Clear:
@@ -97,7 +97,7 @@ namespace pf {
         }
     };
 
-    bool isDestructive(BlendMode mode) noexcept {
+    inline bool isDestructive(BlendMode mode) noexcept {
         switch (mode) {
         case BlendMode::Clear:
         case BlendMode::Copy:
@@ -138,7 +138,16 @@ namespace pf {
         PatternFilter(const PatternFilter & other) noexcept;
         PatternFilter& operator=(const PatternFilter& other) noexcept;
         
+        struct TextData {
+            ColorF fgColor, bgColor;
+            std::optional<glm::vec4> defringingKernal;
+            bool gammaCorrection;
+        };
 
+        struct BlurData {
+            BlurDirection direction;
+            float sigma;
+        };
 
 
         Kind kind;
@@ -147,17 +156,8 @@ namespace pf {
 #ifndef NDEBUG
         union {
 #endif
-            struct TextData {
-                ColorF fgColor, bgColor;
-                std::optional<glm::vec4> defringingKernal;
-                bool gammaCorrection;
-            } text;
-
-            struct BlurData {
-                BlurDirection direction;
-                float sigma;
-            };
-
+            TextData text;
+            BlurData blur;
             ColorMatrix colorMatrix;
 
 #ifndef NDEBUG
@@ -177,16 +177,17 @@ namespace pf {
             RadialGradient = Kind::RadialGradient,
             Pattern = Kind::Pattern;
 
+        struct RadialData {
+            LineSegment2F line;
+            glm::vec2 radii, uvOrigin;
+        };
+
         Kind kind;
 
 #ifndef NDEBUG
         union {
 #endif
-
-            struct RadialData {
-                LineSegment2F line;
-                glm::vec2 radii, uvOrigin;
-            } radial;
+            RadialData radial;
 
             PatternFilter pattern;
 
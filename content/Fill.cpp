@@ -0,0 +1,278 @@
+#include "Fill.hpp"
+#include "../simd/Simd.hpp"
+
+#include <algorithm>
+
+namespace pf {
+	bool windingIsInside(int32_t winding, FillRule rule) noexcept {
+		switch (rule) {
+		case FillRule::EvenOdd:
+			return windingIsInside<FillRule::EvenOdd>(winding);
+		default:
+			return windingIsInside<FillRule::Winding>(winding);
+		}
+	}
+
+	CoverageAccumulator::CoverageAccumulator()
+		: CoverageAccumulator(0, 0)
+	{}
+	CoverageAccumulator::CoverageAccumulator(int _width, int _height)
+		: width(0)
+		, height(0)
+		, rowStride(0)
+	{
+		reset(_width, _height);
+	}
+
+	void CoverageAccumulator::reset(int _width, int _height) {
+		width = std::max(_width, 0);
+		height = std::max(_height, 0);
+		rowStride = (static_cast<std::size_t>(width) + 2 + 3) & ~std::size_t(3);
+		accumulation.assign(rowStride * static_cast<std::size_t>(height), 0.f);
+		sums.resize(rowStride);
+	}
+	void CoverageAccumulator::clear() noexcept {
+		std::fill(accumulation.begin(), accumulation.end(), 0.f);
+	}
+
+	// The scan conversion from font-rs: walk the rows the line crosses, and spread the height it
+	// covers in each over the pixels it passes, weighted by the trapezoid area on their right.
+	template<typename Deposit>
+	static void walkLine(glm::vec2 from, glm::vec2 to, int width, int height, Deposit& deposit) noexcept {
+		if (from.y == to.y) {
+			return;
+		}
+
+		float dir = 1.f;
+		if (from.y > to.y) {
+			std::swap(from, to);
+			dir = -1.f;
+		}
+
+		const float dxdy = (to.x - from.x) / (to.y - from.y);
+		const float maxX = static_cast<float>(width);
+		float x = from.x;
+		const int yStart = static_cast<int>(from.y);
+		const int yEnd = std::min(height, static_cast<int>(std::ceil(to.y)));
+
+		for (int y = yStart; y < yEnd; ++y) {
+			float dy = std::min(static_cast<float>(y + 1), to.y) - std::max(static_cast<float>(y), from.y);
+			// Clamped so that rounding can't step outside the row.
+			float xNext = std::clamp(x + dxdy * dy, 0.f, maxX);
+			float d = dy * dir;
+
+			float x0 = std::min(x, xNext), x1 = std::max(x, xNext);
+			float x0Floor = std::floor(x0), x1Ceil = std::ceil(x1);
+			int x0i = static_cast<int>(x0Floor), x1i = static_cast<int>(x1Ceil);
+
+			if (x1i <= x0i + 1) {
+				// Stays within one pixel.
+				float xmf = 0.5f * (x + xNext) - x0Floor;
+				deposit(y, x0i, d - d * xmf);
+				deposit(y, x0i + 1, d * xmf);
+			}
+			else {
+				float s = 1.f / (x1 - x0);
+				float x0f = x0 - x0Floor;
+				float a0 = 0.5f * s * (1.f - x0f) * (1.f - x0f);
+				float x1f = x1 - x1Ceil + 1.f;
+				float am = 0.5f * s * x1f * x1f;
+
+				deposit(y, x0i, d * a0);
+				if (x1i == x0i + 2) {
+					deposit(y, x0i + 1, d * (1.f - a0 - am));
+				}
+				else {
+					float a1 = s * (1.5f - x0f);
+					deposit(y, x0i + 1, d * (a1 - a0));
+					for (int xi = x0i + 2; xi < x1i - 1; ++xi) {
+						deposit(y, xi, d * s);
+					}
+					float a2 = a1 + static_cast<float>(x1i - x0i - 3) * s;
+					deposit(y, x1i - 1, d * (1.f - a2 - am));
+				}
+				deposit(y, x1i, d * am);
+			}
+
+			x = xNext;
+		}
+	}
+
+	// Clips the line to a width by height grid and hands the pieces that matter to walkLine.
+	template<typename Deposit>
+	static void rasterizeLine(const LineSegment2F& line, int width, int height, Deposit& deposit) noexcept {
+		glm::vec2 from = line.from(), to = line.to();
+		float w = static_cast<float>(width), h = static_cast<float>(height);
+
+		// Clip vertically, only the rows the line crosses matter.
+		if (from.y == to.y || std::max(from.y, to.y) <= 0.f || std::min(from.y, to.y) >= h) {
+			return;
+		}
+		if (std::min(from.y, to.y) < 0.f || std::max(from.y, to.y) > h) {
+			float dxdy = (to.x - from.x) / (to.y - from.y);
+			auto clampY = [&](glm::vec2 p) {
+				float y = std::clamp(p.y, 0.f, h);
+				return glm::vec2{ p.x + (y - p.y) * dxdy, y };
+			};
+			from = clampY(from);
+			to = clampY(to);
+		}
+
+		// Nothing on the right of the grid affects it. Parts on the left cover whole rows, which is
+		// the same as a vertical line along the left edge.
+		if (from.x >= w && to.x >= w) {
+			return;
+		}
+		if (from.x > w || to.x > w) {
+			float y = from.y + (w - from.x) * (to.y - from.y) / (to.x - from.x);
+			(from.x > w ? from : to) = glm::vec2{ w, y };
+		}
+		if (from.x < 0.f || to.x < 0.f) {
+			if (from.x < 0.f && to.x < 0.f) {
+				walkLine(glm::vec2{ 0.f, from.y }, glm::vec2{ 0.f, to.y }, width, height, deposit);
+				return;
+			}
+
+			float y = from.y + (0.f - from.x) * (to.y - from.y) / (to.x - from.x);
+			if (from.x < 0.f) {
+				walkLine(glm::vec2{ 0.f, from.y }, glm::vec2{ 0.f, y }, width, height, deposit);
+				from = glm::vec2{ 0.f, y };
+			}
+			else {
+				walkLine(glm::vec2{ 0.f, y }, glm::vec2{ 0.f, to.y }, width, height, deposit);
+				to = glm::vec2{ 0.f, y };
+			}
+		}
+
+		walkLine(from, to, width, height, deposit);
+	}
+
+	void CoverageAccumulator::addLine(const LineSegment2F& line) noexcept {
+		float* cells = accumulation.data();
+		const std::size_t stride = rowStride;
+		auto deposit = [cells, stride](int y, int x, float value) {
+			cells[static_cast<std::size_t>(y) * stride + x] += value;
+		};
+		rasterizeLine(line, width, height, deposit);
+	}
+
+	SparseCoverageAccumulator::SparseCoverageAccumulator()
+		: SparseCoverageAccumulator(0, 0)
+	{}
+	SparseCoverageAccumulator::SparseCoverageAccumulator(int _width, int _height)
+		: width(std::max(_width, 0))
+		, height(std::max(_height, 0))
+	{}
+
+	void SparseCoverageAccumulator::reset(int _width, int _height) {
+		width = std::max(_width, 0);
+		height = std::max(_height, 0);
+		cells.clear();
+	}
+	void SparseCoverageAccumulator::clear() noexcept {
+		cells.clear();
+	}
+
+	void SparseCoverageAccumulator::addLine(const LineSegment2F& line) {
+		auto deposit = [this](int y, int x, float value) {
+			cells.push_back(Cell{ y, x, value });
+		};
+		rasterizeLine(line, width, height, deposit);
+	}
+
+	void SparseCoverageAccumulator::sortCells() {
+		std::stable_sort(cells.begin(), cells.end(), [](const Cell& lh, const Cell& rh) {
+			return lh.y < rh.y || (lh.y == rh.y && lh.x < rh.x);
+		});
+	}
+
+	void SparseCoverageAccumulator::resolve(FillRule rule, std::vector<CoverageSpan>& spans) {
+		if (rule == FillRule::EvenOdd) {
+			resolve<FillRule::EvenOdd>(spans);
+		}
+		else {
+			resolve<FillRule::Winding>(spans);
+		}
+	}
+
+	void writeSpans(const std::vector<CoverageSpan>& spans, uint8_t* output, std::size_t stride) noexcept {
+		for (const CoverageSpan& span : spans) {
+			uint8_t* row = output + static_cast<std::size_t>(span.y) * stride + span.x;
+			std::fill(row, row + span.length, span.coverage);
+		}
+	}
+
+	// Every level adds [a0, a1, a2, a3] up as [a0, a0 + a1, (a1 + a2) + a0, (a2 + a3) + (a0 + a1)], then adds
+	// the carry from the previous block. The scalar loop spells out the same order.
+#if defined(PF_SIMD_SSE2)
+	static void prefixSumSSE2(const float* input, float* output, std::size_t count) noexcept {
+		__m128 carry = _mm_setzero_ps();
+		for (std::size_t i = 0; i < count; i += 4) {
+			__m128 x = _mm_loadu_ps(input + i);
+			x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+			x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+			x = _mm_add_ps(x, carry);
+			_mm_storeu_ps(output + i, x);
+			carry = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+	}
+#elif defined(PF_SIMD_NEON)
+	static void prefixSumNEON(const float* input, float* output, std::size_t count) noexcept {
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		float32x4_t carry = zero;
+		for (std::size_t i = 0; i < count; i += 4) {
+			float32x4_t x = vld1q_f32(input + i);
+			x = vaddq_f32(x, vextq_f32(zero, x, 3));
+			x = vaddq_f32(x, vextq_f32(zero, x, 2));
+			x = vaddq_f32(x, carry);
+			vst1q_f32(output + i, x);
+			carry = vdupq_laneq_f32(x, 3);
+		}
+	}
+#endif
+
+	void CoverageAccumulator::prefixSum(const float* input, float* output, std::size_t count) noexcept {
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			prefixSumSSE2(input, output, count);
+			return;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			prefixSumNEON(input, output, count);
+			return;
+#endif
+		default:
+			break;
+		}
+
+		float carry = 0.f;
+		for (std::size_t i = 0; i < count; i += 4) {
+			const float* a = input + i;
+			float s01 = a[0] + a[1], s12 = a[1] + a[2], s23 = a[2] + a[3];
+			output[i] = a[0] + carry;
+			output[i + 1] = s01 + carry;
+			output[i + 2] = (s12 + a[0]) + carry;
+			output[i + 3] = (s23 + s01) + carry;
+			carry = output[i + 3];
+		}
+	}
+
+	void CoverageAccumulator::resolve(FillRule rule, float* output, std::size_t stride) noexcept {
+		if (rule == FillRule::EvenOdd) {
+			resolve<FillRule::EvenOdd>(output, stride);
+		}
+		else {
+			resolve<FillRule::Winding>(output, stride);
+		}
+	}
+	void CoverageAccumulator::resolve(FillRule rule, uint8_t* output, std::size_t stride) noexcept {
+		if (rule == FillRule::EvenOdd) {
+			resolve<FillRule::EvenOdd>(output, stride);
+		}
+		else {
+			resolve<FillRule::Winding>(output, stride);
+		}
+	}
+};
@@ -1,5 +1,179 @@
 #pragma once
+#include <cinttypes>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <glm/vec2.hpp>
+#include "../geometry/LineSegment.hpp"
 
 namespace pf {
+	// The fill rule, which determines how self-intersecting paths are filled.
+	// Paths that don't intersect themselves (and have no holes) are unaffected by the choice.
+	enum class FillRule {
+		/// The nonzero rule.
+		Winding,
+		/// The even-odd rule.
+		EvenOdd,
+	};
+
+	template<FillRule Rule>
+	constexpr bool windingIsInside(int32_t winding) noexcept {
+		if constexpr (Rule == FillRule::Winding) {
+			return winding != 0;
+		}
+		else {
+			return (winding & 1) != 0;
+		}
+	}
+	bool windingIsInside(int32_t winding, FillRule rule) noexcept;
+
+	// Maps accumulated signed area coverage to [0, 1]. Even-odd folds the coverage into a triangle
+	// wave, so a pixel wound twice comes out empty. Neither needs a branch.
+	template<FillRule Rule>
+	inline float resolveCoverage(float accumulated) noexcept {
+		float coverage = std::abs(accumulated);
+		if constexpr (Rule == FillRule::Winding) {
+			return std::min(coverage, 1.f);
+		}
+		else {
+			coverage -= 2.f * std::floor(coverage * 0.5f);
+			return 1.f - std::abs(1.f - coverage);
+		}
+	}
+
+	// Accumulates the exact area coverage of line segments over a grid of pixels. Each line deposits
+	// the area it covers in the pixels it crosses, plus the cover it carries to everything on its right,
+	// so a running sum along each row gives the signed coverage of every pixel. Coordinates are in pixels.
+	struct CoverageAccumulator {
+		CoverageAccumulator();
+		CoverageAccumulator(int _width, int _height);
+
+		// Resizes and clears the grid, keeping the allocation when possible.
+		void reset(int _width, int _height);
+		void clear() noexcept;
+
+		// Lines are clipped to the grid; the parts left of it still add their cover to every pixel on the row.
+		void addLine(const LineSegment2F& line) noexcept;
+
+		// Writes one coverage value per pixel, row by row. Stride is in elements.
+		template<FillRule Rule>
+		void resolve(float* output, std::size_t stride) noexcept;
+		template<FillRule Rule>
+		void resolve(uint8_t* output, std::size_t stride) noexcept;
+
+		void resolve(FillRule rule, float* output, std::size_t stride) noexcept;
+		void resolve(FillRule rule, uint8_t* output, std::size_t stride) noexcept;
+
+		// Running sum over a row, count must be a multiple of four. The sum is taken in blocks of four
+		// in the order a SIMD register does it, on every dispatch level, so results are bit identical
+		// whichever kernel runs.
+		static void prefixSum(const float* input, float* output, std::size_t count) noexcept;
+
+		int width, height;
+		// Each row has at least two extra cells, the lines on the right edge spill into them.
+		// Rounded up to a multiple of four for prefixSum.
+		std::size_t rowStride;
+		std::vector<float> accumulation;
+		// The running sum of the row being resolved, sized by reset so resolve doesn't allocate.
+		std::vector<float> sums;
+	};
+
+	// A run of pixels on one row that share the same coverage.
+	struct CoverageSpan {
+		int32_t x, y;
+		int32_t length;
+		uint8_t coverage;
+	};
+
+	// Computes the same coverage as CoverageAccumulator, but only stores the cells that lines pass
+	// through instead of the whole grid, so memory follows the length of the edges rather than the
+	// area. Coverage is constant between cells, so the result comes out as spans.
+	struct SparseCoverageAccumulator {
+		struct Cell {
+			int32_t y, x;
+			float delta;
+		};
+
+		SparseCoverageAccumulator();
+		SparseCoverageAccumulator(int _width, int _height);
+
+		// Clears the cells and changes the size of the grid, keeping the allocation.
+		void reset(int _width, int _height);
+		void clear() noexcept;
+
+		void addLine(const LineSegment2F& line);
+
+		// Appends the runs of nonzero coverage to spans, sorted by row and then by x.
+		// Adjacent runs with the same coverage are merged.
+		template<FillRule Rule>
+		void resolve(std::vector<CoverageSpan>& spans);
+		void resolve(FillRule rule, std::vector<CoverageSpan>& spans);
+
+		int width, height;
+		std::vector<Cell> cells;
+	private:
+		// Orders the cells by row and x. Cells that land on the same pixel keep the order they were
+		// added in, so their sum is the same on every run.
+		void sortCells();
+	};
+
+	// Copies the coverage of spans into a dense buffer, pixels outside of them are left alone.
+	void writeSpans(const std::vector<CoverageSpan>& spans, uint8_t* output, std::size_t stride) noexcept;
+
+	template<FillRule Rule>
+	void CoverageAccumulator::resolve(float* output, std::size_t stride) noexcept {
+		const float* row = accumulation.data();
+		for (int y = 0; y < height; ++y, row += rowStride, output += stride) {
+			prefixSum(row, sums.data(), rowStride);
+			for (int x = 0; x < width; ++x) {
+				output[x] = resolveCoverage<Rule>(sums[x]);
+			}
+		}
+	}
+	template<FillRule Rule>
+	void CoverageAccumulator::resolve(uint8_t* output, std::size_t stride) noexcept {
+		const float* row = accumulation.data();
+		for (int y = 0; y < height; ++y, row += rowStride, output += stride) {
+			prefixSum(row, sums.data(), rowStride);
+			for (int x = 0; x < width; ++x) {
+				output[x] = static_cast<uint8_t>(resolveCoverage<Rule>(sums[x]) * 255.f + 0.5f);
+			}
+		}
+	}
+
+	template<FillRule Rule>
+	void SparseCoverageAccumulator::resolve(std::vector<CoverageSpan>& spans) {
+		sortCells();
+
+		const std::size_t count = cells.size();
+		std::size_t i = 0;
+		while (i < count) {
+			const int32_t y = cells[i].y;
+			float sum = 0.f;
+
+			while (i < count && cells[i].y == y) {
+				const int32_t x = cells[i].x;
+				for (; i < count && cells[i].y == y && cells[i].x == x; ++i) {
+					sum += cells[i].delta;
+				}
+
+				// The coverage holds until the next cell on the row, or the end of the row.
+				int32_t end = (i < count && cells[i].y == y) ? std::min(cells[i].x, width) : width;
+				uint8_t coverage = static_cast<uint8_t>(resolveCoverage<Rule>(sum) * 255.f + 0.5f);
+				if (x >= end || coverage == 0) {
+					continue;
+				}
 
-};
\ No newline at end of file
+				if (!spans.empty()) {
+					CoverageSpan& last = spans.back();
+					if (last.y == y && last.x + last.length == x && last.coverage == coverage) {
+						last.length += end - x;
+						continue;
+					}
+				}
+				spans.push_back(CoverageSpan{ x, y, end - x, coverage });
+			}
+		}
+	}
+};
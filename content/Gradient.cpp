@@ -0,0 +1,467 @@
+#include "Gradient.hpp"
+#include "../simd/Simd.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace pf {
+	ColorStop::ColorStop(const ColorU& _color, float _offset) noexcept
+		: offset(_offset)
+		, color(_color)
+	{}
+
+	Gradient::Gradient(const GradientGeometry& _geometry) noexcept
+		: geometry(_geometry)
+		, wrap(GradientWrap::Clamp)
+	{}
+
+	Gradient Gradient::linear(const LineSegment2F& line) noexcept {
+		return Gradient{ GradientGeometry{ GradientGeometry::Linear, line, glm::vec2{ 0.f }, Transform2F{} } };
+	}
+	Gradient Gradient::linearFromPoints(const glm::vec2& from, const glm::vec2& to) noexcept {
+		return linear(LineSegment2F{ from, to });
+	}
+	Gradient Gradient::radial(const LineSegment2F& line, const glm::vec2& radii) noexcept {
+		return Gradient{ GradientGeometry{ GradientGeometry::Radial, line, radii, Transform2F{} } };
+	}
+	Gradient Gradient::radial(const glm::vec2& center, const glm::vec2& radii) noexcept {
+		return radial(LineSegment2F{ center, center }, radii);
+	}
+
+	void Gradient::add(const ColorStop& stop) {
+		auto position = std::upper_bound(colorStops.begin(), colorStops.end(), stop.offset, [](float offset, const ColorStop& other) {
+			return offset < other.offset;
+		});
+		colorStops.insert(position, stop);
+	}
+	void Gradient::addColorStop(const ColorU& color, float offset) {
+		add(ColorStop{ color, offset });
+	}
+
+	const std::vector<ColorStop>& Gradient::stops() const noexcept {
+		return colorStops;
+	}
+
+	// The color between two stops, at an offset t that is past lower.
+	static ColorU interpolateStops(const ColorStop& lower, const ColorStop& upper, float t) noexcept {
+		float denom = upper.offset - lower.offset;
+		if (denom == 0.f) {
+			return lower.color;
+		}
+
+		float ratio = std::min((t - lower.offset) / denom, 1.f);
+		return lower.color.to_f32().lerp(upper.color.to_f32(), ratio).to_u8();
+	}
+
+	// Whether the stop sorts before offset t when looking for the upper stop of t. Stops at zero always
+	// do, so that t = 0 blends from the first stop.
+	static bool stopPrecedes(const ColorStop& stop, float t) noexcept {
+		return stop.offset < t || stop.offset == 0.f;
+	}
+
+	ColorU Gradient::sample(float t) const noexcept {
+		if (colorStops.empty()) {
+			return ColorU::transparent_black();
+		}
+
+		t = std::clamp(t, 0.f, 1.f);
+		std::size_t lastIndex = colorStops.size() - 1;
+
+		auto position = std::partition_point(colorStops.begin(), colorStops.end(), [t](const ColorStop& stop) {
+			return stopPrecedes(stop, t);
+		});
+		std::size_t upperIndex = std::min(static_cast<std::size_t>(position - colorStops.begin()), lastIndex);
+		std::size_t lowerIndex = upperIndex > 0 ? upperIndex - 1 : upperIndex;
+
+		return interpolateStops(colorStops[lowerIndex], colorStops[upperIndex], t);
+	}
+
+	bool Gradient::isOpaque() const noexcept {
+		return std::all_of(colorStops.begin(), colorStops.end(), [](const ColorStop& stop) {
+			return stop.color.is_opaque();
+		});
+	}
+	bool Gradient::isFullyTransparent() const noexcept {
+		return std::all_of(colorStops.begin(), colorStops.end(), [](const ColorStop& stop) {
+			return stop.color.is_fully_transparent();
+		});
+	}
+
+	// This isn't correct for radial gradients, as transforms can turn the circles into ellipses.
+	void Gradient::applyTransform(const Transform2F& form) noexcept {
+		if (form.isIdentity()) {
+			return;
+		}
+
+		if (geometry.kind == GradientGeometry::Linear) {
+			geometry.line = form.apply(geometry.line);
+		}
+		else {
+			geometry.transform = form.apply(geometry.transform);
+		}
+	}
+
+	// Exact round(x / 255) for x in [0, 255 * 255].
+	static uint32_t div255(uint32_t x) noexcept {
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	static uint32_t packPremultiplied(const ColorU& color) noexcept {
+		uint8_t bytes[4] = {
+			static_cast<uint8_t>(div255(uint32_t(color.r) * color.a)),
+			static_cast<uint8_t>(div255(uint32_t(color.g) * color.a)),
+			static_cast<uint8_t>(div255(uint32_t(color.b) * color.a)),
+			color.a,
+		};
+
+		uint32_t result;
+		std::memcpy(&result, bytes, sizeof(result));
+		return result;
+	}
+
+	GradientRamp::GradientRamp(const Gradient& gradient, uint32_t _length)
+		: kind(gradient.geometry.kind)
+		, wrap(gradient.wrap)
+		, direction(0.f)
+		, base(0.f)
+		, from(0.f)
+		, centers(0.f)
+		, startRadius(0.f)
+		, deltaRadius(0.f)
+		, a(0.f)
+		, inverseA(0.f)
+	{
+		assert(_length >= 2);
+		texels.resize(_length);
+
+		// The same colors as Gradient::sample, with the stop search replaced by a cursor that only
+		// moves forward as t grows.
+		const std::vector<ColorStop>& stops = gradient.stops();
+		std::size_t upper = 0;
+		for (uint32_t i = 0; i < _length; ++i) {
+			if (stops.empty()) {
+				texels[i] = 0;
+				continue;
+			}
+
+			float t = static_cast<float>(i) / static_cast<float>(_length - 1);
+			while (upper < stops.size() && stopPrecedes(stops[upper], t)) {
+				++upper;
+			}
+			std::size_t upperIndex = std::min(upper, stops.size() - 1);
+			std::size_t lowerIndex = upperIndex > 0 ? upperIndex - 1 : upperIndex;
+
+			texels[i] = packPremultiplied(interpolateStops(stops[lowerIndex], stops[upperIndex], t));
+		}
+
+		const GradientGeometry& geometry = gradient.geometry;
+		if (kind == GradientGeometry::Linear) {
+			glm::vec2 vector = geometry.line.vector();
+			float lengthSquared = glm::dot(vector, vector);
+			if (lengthSquared > 0.f) {
+				direction = vector / lengthSquared;
+				base = -glm::dot(geometry.line.from(), direction);
+			}
+			return;
+		}
+
+		toGradient = geometry.transform.inverse();
+		from = geometry.line.from();
+		centers = geometry.line.vector();
+		startRadius = geometry.radii.x;
+		deltaRadius = geometry.radii.y - geometry.radii.x;
+		a = centers.x * centers.x + centers.y * centers.y - deltaRadius * deltaRadius;
+		inverseA = a != 0.f ? 1.f / a : 0.f;
+	}
+
+	// Beyond this every float is an integer, so clamping there keeps the fractional part of t intact
+	// and keeps t within the range of int32.
+	static constexpr float MaxOffset = 8388608.f;
+
+	static uint32_t rampIndex(float t, GradientWrap wrap, float scale) noexcept {
+		if (wrap == GradientWrap::Repeat) {
+			t = std::clamp(t, -MaxOffset, MaxOffset);
+			t -= std::floor(t);
+		}
+		else {
+			t = std::clamp(t, 0.f, 1.f);
+		}
+		return static_cast<uint32_t>(t * scale + 0.5f);
+	}
+
+	ColorU GradientRamp::lookup(float t) const noexcept {
+		uint32_t texel = texels[rampIndex(t, wrap, static_cast<float>(texels.size() - 1))];
+		uint8_t bytes[4];
+		std::memcpy(bytes, &texel, sizeof(texel));
+		return ColorU{ bytes[0], bytes[1], bytes[2], bytes[3] };
+	}
+
+	// The radial offset for a point in gradient space, given relative to the center of the first
+	// circle. Valid is unset when the point is outside of the cone. The kernels below repeat these
+	// steps lane by lane.
+	static float radialOffset(glm::vec2 offset, glm::vec2 centers, float r0, float dr, float a, float inverseA, bool& valid) noexcept {
+		float b = offset.x * centers.x + offset.y * centers.y + r0 * dr;
+		float c = offset.x * offset.x + offset.y * offset.y - r0 * r0;
+		float discriminant = b * b - a * c;
+
+		float root = std::sqrt(std::max(discriminant, 0.f));
+		float t0 = (b + root) * inverseA, t1 = (b - root) * inverseA;
+		float high = std::max(t0, t1), low = std::min(t0, t1);
+
+		bool highValid = r0 + high * dr >= 0.f, lowValid = r0 + low * dr >= 0.f;
+		valid = discriminant >= 0.f && (highValid || lowValid);
+		return highValid ? high : low;
+	}
+
+	// Kernels fill count pixels from pixel index first on, and return how many they handled. The pixel
+	// at index i is at start + i along x.
+#if defined(PF_SIMD_SSE2)
+	static __m128i rampIndexSSE2(__m128 t, GradientWrap wrap, __m128 scale) noexcept {
+		if (wrap == GradientWrap::Repeat) {
+			t = _mm_min_ps(_mm_max_ps(t, _mm_set1_ps(-MaxOffset)), _mm_set1_ps(MaxOffset));
+			__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+			__m128 floor = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, t), _mm_set1_ps(1.f)));
+			t = _mm_sub_ps(t, floor);
+		}
+		else {
+			t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.f));
+		}
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(t, scale), _mm_set1_ps(0.5f)));
+	}
+
+	static std::size_t fillLinearSSE2(const uint32_t* texels, float scale, GradientWrap wrap, glm::vec2 start, glm::vec2 direction, float base, std::size_t count, uint32_t* output) noexcept {
+		const __m128 lane = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+		const __m128 scales = _mm_set1_ps(scale);
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_add_ps(_mm_set1_ps(start.x), _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane));
+			__m128 t = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(direction.x)), _mm_set1_ps(start.y * direction.y)),
+				_mm_set1_ps(base));
+
+			alignas(16) uint32_t index[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(index), rampIndexSSE2(t, wrap, scales));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_setr_epi32(
+				static_cast<int>(texels[index[0]]), static_cast<int>(texels[index[1]]),
+				static_cast<int>(texels[index[2]]), static_cast<int>(texels[index[3]])));
+		}
+		return i;
+	}
+
+	PF_TARGET_AVX2 static std::size_t fillLinearAVX2(const uint32_t* texels, float scale, GradientWrap wrap, glm::vec2 start, glm::vec2 direction, float base, std::size_t count, uint32_t* output) noexcept {
+		const __m256 lane = _mm256_set_ps(7.f, 6.f, 5.f, 4.f, 3.f, 2.f, 1.f, 0.f);
+		const __m256 scales = _mm256_set1_ps(scale);
+		const __m256 one = _mm256_set1_ps(1.f);
+
+		std::size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_add_ps(_mm256_set1_ps(start.x), _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lane));
+			__m256 t = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(direction.x)), _mm256_set1_ps(start.y * direction.y)),
+				_mm256_set1_ps(base));
+
+			if (wrap == GradientWrap::Repeat) {
+				t = _mm256_min_ps(_mm256_max_ps(t, _mm256_set1_ps(-MaxOffset)), _mm256_set1_ps(MaxOffset));
+				t = _mm256_sub_ps(t, _mm256_floor_ps(t));
+			}
+			else {
+				t = _mm256_min_ps(_mm256_max_ps(t, _mm256_setzero_ps()), one);
+			}
+			__m256i index = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(t, scales), _mm256_set1_ps(0.5f)));
+
+			__m256i colors = _mm256_i32gather_epi32(reinterpret_cast<const int*>(texels), index, 4);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), colors);
+		}
+		return i;
+	}
+
+	static std::size_t fillRadialSSE2(const uint32_t* texels, float scale, GradientWrap wrap, glm::vec2 start, const Transform2F& toGradient,
+		glm::vec2 from, glm::vec2 centers, float r0, float dr, float a, float inverseA, std::size_t count, uint32_t* output) noexcept
+	{
+		const __m128 lane = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+		const __m128 scales = _mm_set1_ps(scale);
+		const __m128 zero = _mm_setzero_ps();
+
+		// Gradient space positions of the pixels, before the per pixel step along x.
+		const glm::vec2 origin = toGradient.apply(start) - from;
+		const glm::vec2 step = toGradient.matrix[0];
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 n = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane);
+			__m128 x = _mm_add_ps(_mm_set1_ps(origin.x), _mm_mul_ps(n, _mm_set1_ps(step.x)));
+			__m128 y = _mm_add_ps(_mm_set1_ps(origin.y), _mm_mul_ps(n, _mm_set1_ps(step.y)));
+
+			__m128 b = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(centers.x)), _mm_mul_ps(y, _mm_set1_ps(centers.y))), _mm_set1_ps(r0 * dr));
+			__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_set1_ps(r0 * r0));
+			__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(_mm_set1_ps(a), c));
+
+			__m128 root = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+			__m128 t0 = _mm_mul_ps(_mm_add_ps(b, root), _mm_set1_ps(inverseA));
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(b, root), _mm_set1_ps(inverseA));
+			__m128 high = _mm_max_ps(t0, t1), low = _mm_min_ps(t0, t1);
+
+			__m128 highValid = _mm_cmpge_ps(_mm_add_ps(_mm_set1_ps(r0), _mm_mul_ps(high, _mm_set1_ps(dr))), zero);
+			__m128 lowValid = _mm_cmpge_ps(_mm_add_ps(_mm_set1_ps(r0), _mm_mul_ps(low, _mm_set1_ps(dr))), zero);
+			__m128 valid = _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_or_ps(highValid, lowValid));
+			__m128 t = _mm_or_ps(_mm_and_ps(highValid, high), _mm_andnot_ps(highValid, low));
+
+			alignas(16) uint32_t index[4];
+			alignas(16) uint32_t mask[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(index), rampIndexSSE2(t, wrap, scales));
+			_mm_store_ps(reinterpret_cast<float*>(mask), valid);
+			for (int k = 0; k < 4; ++k) {
+				output[i + k] = texels[index[k]] & mask[k];
+			}
+		}
+		return i;
+	}
+#elif defined(PF_SIMD_NEON)
+	static uint32x4_t rampIndexNEON(float32x4_t t, GradientWrap wrap, float32x4_t scale) noexcept {
+		if (wrap == GradientWrap::Repeat) {
+			t = vminq_f32(vmaxq_f32(t, vdupq_n_f32(-MaxOffset)), vdupq_n_f32(MaxOffset));
+			t = vsubq_f32(t, vrndmq_f32(t));
+		}
+		else {
+			t = vminq_f32(vmaxq_f32(t, vdupq_n_f32(0.f)), vdupq_n_f32(1.f));
+		}
+		return vcvtq_u32_f32(vaddq_f32(vmulq_f32(t, scale), vdupq_n_f32(0.5f)));
+	}
+
+	static std::size_t fillLinearNEON(const uint32_t* texels, float scale, GradientWrap wrap, glm::vec2 start, glm::vec2 direction, float base, std::size_t count, uint32_t* output) noexcept {
+		const float laneValues[4] = { 0.f, 1.f, 2.f, 3.f };
+		const float32x4_t lane = vld1q_f32(laneValues);
+		const float32x4_t scales = vdupq_n_f32(scale);
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t x = vaddq_f32(vdupq_n_f32(start.x), vaddq_f32(vdupq_n_f32(static_cast<float>(i)), lane));
+			float32x4_t t = vaddq_f32(
+				vaddq_f32(vmulq_f32(x, vdupq_n_f32(direction.x)), vdupq_n_f32(start.y * direction.y)),
+				vdupq_n_f32(base));
+
+			uint32_t index[4];
+			vst1q_u32(index, rampIndexNEON(t, wrap, scales));
+			for (int k = 0; k < 4; ++k) {
+				output[i + k] = texels[index[k]];
+			}
+		}
+		return i;
+	}
+
+	static std::size_t fillRadialNEON(const uint32_t* texels, float scale, GradientWrap wrap, glm::vec2 start, const Transform2F& toGradient,
+		glm::vec2 from, glm::vec2 centers, float r0, float dr, float a, float inverseA, std::size_t count, uint32_t* output) noexcept
+	{
+		const float laneValues[4] = { 0.f, 1.f, 2.f, 3.f };
+		const float32x4_t lane = vld1q_f32(laneValues);
+		const float32x4_t scales = vdupq_n_f32(scale);
+		const float32x4_t zero = vdupq_n_f32(0.f);
+
+		const glm::vec2 origin = toGradient.apply(start) - from;
+		const glm::vec2 step = toGradient.matrix[0];
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			float32x4_t n = vaddq_f32(vdupq_n_f32(static_cast<float>(i)), lane);
+			float32x4_t x = vaddq_f32(vdupq_n_f32(origin.x), vmulq_f32(n, vdupq_n_f32(step.x)));
+			float32x4_t y = vaddq_f32(vdupq_n_f32(origin.y), vmulq_f32(n, vdupq_n_f32(step.y)));
+
+			float32x4_t b = vaddq_f32(vaddq_f32(vmulq_f32(x, vdupq_n_f32(centers.x)), vmulq_f32(y, vdupq_n_f32(centers.y))), vdupq_n_f32(r0 * dr));
+			float32x4_t c = vsubq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)), vdupq_n_f32(r0 * r0));
+			float32x4_t discriminant = vsubq_f32(vmulq_f32(b, b), vmulq_f32(vdupq_n_f32(a), c));
+
+			float32x4_t root = vsqrtq_f32(vmaxq_f32(discriminant, zero));
+			float32x4_t t0 = vmulq_f32(vaddq_f32(b, root), vdupq_n_f32(inverseA));
+			float32x4_t t1 = vmulq_f32(vsubq_f32(b, root), vdupq_n_f32(inverseA));
+			float32x4_t high = vmaxq_f32(t0, t1), low = vminq_f32(t0, t1);
+
+			uint32x4_t highValid = vcgeq_f32(vaddq_f32(vdupq_n_f32(r0), vmulq_f32(high, vdupq_n_f32(dr))), zero);
+			uint32x4_t lowValid = vcgeq_f32(vaddq_f32(vdupq_n_f32(r0), vmulq_f32(low, vdupq_n_f32(dr))), zero);
+			uint32x4_t valid = vandq_u32(vcgeq_f32(discriminant, zero), vorrq_u32(highValid, lowValid));
+			float32x4_t t = vbslq_f32(highValid, high, low);
+
+			uint32_t index[4], mask[4];
+			vst1q_u32(index, rampIndexNEON(t, wrap, scales));
+			vst1q_u32(mask, valid);
+			for (int k = 0; k < 4; ++k) {
+				output[i + k] = texels[index[k]] & mask[k];
+			}
+		}
+		return i;
+	}
+#endif
+
+	void GradientRamp::fillSpan(const glm::vec2& start, std::size_t count, uint8_t* output) const noexcept {
+		uint32_t* pixels = reinterpret_cast<uint32_t*>(output);
+		const float scale = static_cast<float>(texels.size() - 1);
+		std::size_t i = 0;
+
+		if (kind == GradientGeometry::Linear) {
+			switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+			case SimdLevel::AVX2:
+				i = fillLinearAVX2(texels.data(), scale, wrap, start, direction, base, count, pixels);
+				break;
+			case SimdLevel::SSE2:
+				i = fillLinearSSE2(texels.data(), scale, wrap, start, direction, base, count, pixels);
+				break;
+#elif defined(PF_SIMD_NEON)
+			case SimdLevel::NEON:
+				i = fillLinearNEON(texels.data(), scale, wrap, start, direction, base, count, pixels);
+				break;
+#endif
+			default:
+				break;
+			}
+
+			for (; i < count; ++i) {
+				float x = start.x + static_cast<float>(i);
+				float t = (x * direction.x + start.y * direction.y) + base;
+				pixels[i] = texels[rampIndex(t, wrap, scale)];
+			}
+			return;
+		}
+
+		// A cone whose quadratic degenerates to a linear equation, rare enough to shade point by point.
+		if (a == 0.f) {
+			for (; i < count; ++i) {
+				glm::vec2 point = toGradient.apply(start + glm::vec2{ static_cast<float>(i), 0.f }) - from;
+				float b = glm::dot(point, centers) + startRadius * deltaRadius;
+				float c = glm::dot(point, point) - startRadius * startRadius;
+				float t = b != 0.f ? c / (2.f * b) : -1.f;
+				bool valid = b != 0.f && startRadius + t * deltaRadius >= 0.f;
+				pixels[i] = valid ? texels[rampIndex(t, wrap, scale)] : 0;
+			}
+			return;
+		}
+
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			i = fillRadialSSE2(texels.data(), scale, wrap, start, toGradient, from, centers, startRadius, deltaRadius, a, inverseA, count, pixels);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = fillRadialNEON(texels.data(), scale, wrap, start, toGradient, from, centers, startRadius, deltaRadius, a, inverseA, count, pixels);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		const glm::vec2 origin = toGradient.apply(start) - from;
+		const glm::vec2 step = toGradient.matrix[0];
+		for (; i < count; ++i) {
+			float n = static_cast<float>(i);
+			glm::vec2 point{ origin.x + n * step.x, origin.y + n * step.y };
+			bool valid;
+			float t = radialOffset(point, centers, startRadius, deltaRadius, a, inverseA, valid);
+			pixels[i] = valid ? texels[rampIndex(t, wrap, scale)] : 0;
+		}
+	}
+};
\ No newline at end of file
@@ -1,5 +1,107 @@
 #pragma once
+#include <cinttypes>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "../color/color.hpp"
+#include "../geometry/LineSegment.hpp"
+#include "../geometry/Transform2d.hpp"
 
 namespace pf {
+	struct ColorStop {
+		ColorStop(const ColorU& _color, float _offset) noexcept;
+
+		// Between 0 and 1 inclusive, 0 being the start of the gradient.
+		float offset;
+		ColorU color;
+	};
+
+	enum class GradientWrap {
+		/// The area before the gradient gets the color of the first stop, and the area after it the
+		/// color of the last stop.
+		Clamp,
+		/// The gradient repeats indefinitely.
+		Repeat,
+	};
+
+	struct GradientGeometry {
+		enum class Kind {
+			Linear,
+			Radial,
+		};
+		static constexpr Kind
+			Linear = Kind::Linear,
+			Radial = Kind::Radial;
+
+		Kind kind;
+		// In scene coordinates. For radial gradients this connects the centers of the two circles, and
+		// has zero length for the common single circle case.
+		LineSegment2F line;
+		// Radial only, the radii of the two circles.
+		glm::vec2 radii;
+		// Radial only, from gradient space into scene space.
+		Transform2F transform;
+	};
+
+	struct Gradient {
+		static Gradient linear(const LineSegment2F& line) noexcept;
+		static Gradient linearFromPoints(const glm::vec2& from, const glm::vec2& to) noexcept;
+		static Gradient radial(const LineSegment2F& line, const glm::vec2& radii) noexcept;
+		static Gradient radial(const glm::vec2& center, const glm::vec2& radii) noexcept;
+
+		// Keeps the stops sorted by offset, after any stops with the same offset.
+		void add(const ColorStop& stop);
+		void addColorStop(const ColorU& color, float offset);
+
+		const std::vector<ColorStop>& stops() const noexcept;
+
+		// The color at offset t, clamped to [0, 1].
+		ColorU sample(float t) const noexcept;
+
+		bool isOpaque() const noexcept;
+		bool isFullyTransparent() const noexcept;
+
+		void applyTransform(const Transform2F& form) noexcept;
+
+		GradientGeometry geometry;
+		GradientWrap wrap;
+	private:
+		Gradient(const GradientGeometry& _geometry) noexcept;
+
+		std::vector<ColorStop> colorStops;
+	};
+
+	// A gradient baked for drawing on the CPU. The stops are sampled once into a table of premultiplied
+	// colors, so shading a pixel costs a lookup instead of a search over the stops.
+	struct GradientRamp {
+		static constexpr uint32_t DefaultLength = 256;
+		static constexpr uint32_t FineLength = 1024;
+
+		GradientRamp(const Gradient& gradient, uint32_t _length = DefaultLength);
+
+		// The premultiplied RGBA8 color at offset t, wrapped as the gradient says.
+		ColorU lookup(float t) const noexcept;
+
+		// Writes count premultiplied RGBA8 pixels whose centers start at start, in scene coordinates,
+		// and step by one along x. Radial pixels outside of the cone are transparent.
+		void fillSpan(const glm::vec2& start, std::size_t count, uint8_t* output) const noexcept;
+
+		GradientGeometry::Kind kind;
+		GradientWrap wrap;
+		// Premultiplied RGBA8, in memory order.
+		std::vector<uint32_t> texels;
+	private:
+		// Linear: the offset at a point is dot(point, direction) + base.
+		glm::vec2 direction;
+		float base;
 
+		// Radial: the point is moved into gradient space with toGradient, then the offset is the
+		// largest t for which it lies on the circle of center from + t * centers and radius
+		// startRadius + t * deltaRadius. That is a quadratic in t with leading coefficient a.
+		Transform2F toGradient;
+		glm::vec2 from, centers;
+		float startRadius, deltaRadius;
+		float a, inverseA;
+	};
 };
\ No newline at end of file
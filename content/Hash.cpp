@@ -0,0 +1,81 @@
+#include "Hash.hpp"
+
+#include <cstring>
+
+namespace pf {
+	static constexpr uint64_t
+		Prime1 = 0x9E3779B185EBCA87ull,
+		Prime2 = 0xC2B2AE3D27D4EB4Full,
+		Prime3 = 0x165667B19E3779F9ull,
+		Prime4 = 0x85EBCA77C2B2AE63ull,
+		Prime5 = 0x27D4EB2F165667C5ull;
+
+	static uint64_t rotateLeft(uint64_t value, int amount) noexcept {
+		return (value << amount) | (value >> (64 - amount));
+	}
+	static uint64_t read64(const uint8_t* data) noexcept {
+		uint64_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+	static uint32_t read32(const uint8_t* data) noexcept {
+		uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static uint64_t hashRound(uint64_t accumulator, uint64_t input) noexcept {
+		accumulator += input * Prime2;
+		return rotateLeft(accumulator, 31) * Prime1;
+	}
+	static uint64_t mergeRound(uint64_t accumulator, uint64_t lane) noexcept {
+		accumulator ^= hashRound(0, lane);
+		return accumulator * Prime1 + Prime4;
+	}
+
+	uint64_t hashBytes(const void* data, std::size_t length, uint64_t seed) noexcept {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		const uint8_t* end = bytes + length;
+		uint64_t hash;
+
+		if (length >= 32) {
+			uint64_t lanes[4] = { seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 };
+			for (; end - bytes >= 32; bytes += 32) {
+				for (int i = 0; i < 4; ++i) {
+					lanes[i] = hashRound(lanes[i], read64(bytes + 8 * i));
+				}
+			}
+
+			hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+			for (int i = 0; i < 4; ++i) {
+				hash = mergeRound(hash, lanes[i]);
+			}
+		}
+		else {
+			hash = seed + Prime5;
+		}
+
+		hash += static_cast<uint64_t>(length);
+
+		for (; end - bytes >= 8; bytes += 8) {
+			hash ^= hashRound(0, read64(bytes));
+			hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+		}
+		if (end - bytes >= 4) {
+			hash ^= static_cast<uint64_t>(read32(bytes)) * Prime1;
+			hash = rotateLeft(hash, 23) * Prime2 + Prime3;
+			bytes += 4;
+		}
+		for (; bytes < end; ++bytes) {
+			hash ^= *bytes * Prime5;
+			hash = rotateLeft(hash, 11) * Prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= Prime2;
+		hash ^= hash >> 29;
+		hash *= Prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+};
\ No newline at end of file
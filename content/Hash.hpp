@@ -0,0 +1,9 @@
+#pragma once
+#include <cinttypes>
+#include <cstddef>
+
+namespace pf {
+	// A fast non-cryptographic hash, XXH64. The bulk of the input runs through four independent 64 bit
+	// lanes, so the main loop pipelines well and vectorizes where the target has 64 bit multiplies.
+	uint64_t hashBytes(const void* data, std::size_t length, uint64_t seed = 0) noexcept;
+};
\ No newline at end of file
@@ -1,22 +1,216 @@
 #include "Orientation.hpp"
 #include "Outline.hpp"
+#include "ContourSoA.hpp"
+
+#include "../simd/Simd.hpp"
 
 namespace pf {
-	Orientation orientationOf(const Outline& outline) {
+	// The shoelace sum is evaluated relative to the first point of the contour. That keeps the products
+	// small for contours far from the origin, and makes the two terms touching the first point vanish,
+	// so the kernels only sum cross(q[i], q[i + 1]) for i in [1, n - 2]. They take an exclusive end, handle
+	// as many terms as fit their width and return where the scalar tail has to pick up.
+
+	static const glm::vec2& positionAt(const Contour::Point* points, std::size_t i) noexcept {
+		return points[i].point;
+	}
+
+#if defined(PF_SIMD_SSE2)
+	static float reduceCross(__m128 v) noexcept {
+		// Lanes hold x * y' and y * x' pairs.
+		__m128 diff = _mm_sub_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(_mm_add_ss(diff, _mm_movehl_ps(diff, diff)));
+	}
+
+	static std::size_t crossSumSSE2(const Contour::Point* points, std::size_t first, std::size_t end, const glm::vec2& origin, float& sum) noexcept {
+		const __m128 o = _mm_setr_ps(origin.x, origin.y, origin.x, origin.y);
+		__m128 acc = _mm_setzero_ps();
+
+		std::size_t i = first;
+		for (; i + 2 <= end; i += 2) {
+			// a = q[i] q[i + 1], b = q[i + 1] q[i + 2]
+			__m128 a = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&positionAt(points, i)));
+			a = _mm_loadh_pi(a, reinterpret_cast<const __m64*>(&positionAt(points, i + 1)));
+			__m128 b = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&positionAt(points, i + 1)));
+			b = _mm_loadh_pi(b, reinterpret_cast<const __m64*>(&positionAt(points, i + 2)));
+			a = _mm_sub_ps(a, o);
+			b = _mm_sub_ps(b, o);
+
+			acc = _mm_add_ps(acc, _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1))));
+		}
+
+		sum = reduceCross(acc);
+		return i;
+	}
+	static std::size_t crossSumSSE2(const float* xs, const float* ys, std::size_t first, std::size_t end, const glm::vec2& origin, float& sum) noexcept {
+		const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y);
+		__m128 acc = _mm_setzero_ps();
+
+		std::size_t i = first;
+		for (; i + 4 <= end; i += 4) {
+			__m128 x0 = _mm_sub_ps(_mm_loadu_ps(xs + i), ox), y0 = _mm_sub_ps(_mm_loadu_ps(ys + i), oy);
+			__m128 x1 = _mm_sub_ps(_mm_loadu_ps(xs + i + 1), ox), y1 = _mm_sub_ps(_mm_loadu_ps(ys + i + 1), oy);
+			acc = _mm_add_ps(acc, _mm_sub_ps(_mm_mul_ps(x0, y1), _mm_mul_ps(y0, x1)));
+		}
+
+		acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+		sum = _mm_cvtss_f32(_mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1))));
+		return i;
+	}
+
+	PF_TARGET_AVX2 static std::size_t crossSumAVX2(const float* xs, const float* ys, std::size_t first, std::size_t end, const glm::vec2& origin, float& sum) noexcept {
+		const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y);
+		__m256 acc = _mm256_setzero_ps();
+
+		std::size_t i = first;
+		for (; i + 8 <= end; i += 8) {
+			__m256 x0 = _mm256_sub_ps(_mm256_loadu_ps(xs + i), ox), y0 = _mm256_sub_ps(_mm256_loadu_ps(ys + i), oy);
+			__m256 x1 = _mm256_sub_ps(_mm256_loadu_ps(xs + i + 1), ox), y1 = _mm256_sub_ps(_mm256_loadu_ps(ys + i + 1), oy);
+			acc = _mm256_add_ps(acc, _mm256_sub_ps(_mm256_mul_ps(x0, y1), _mm256_mul_ps(y0, x1)));
+		}
+
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		sum = _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, _MM_SHUFFLE(1, 1, 1, 1))));
+		return i;
+	}
+#elif defined(PF_SIMD_NEON)
+	static std::size_t crossSumNEON(const Contour::Point* points, std::size_t first, std::size_t end, const glm::vec2& origin, float& sum) noexcept {
+		const float32x4_t o = { origin.x, origin.y, origin.x, origin.y };
+		float32x4_t acc = vdupq_n_f32(0.f);
+
+		std::size_t i = first;
+		for (; i + 2 <= end; i += 2) {
+			float32x4_t a = vcombine_f32(vld1_f32(&positionAt(points, i).x), vld1_f32(&positionAt(points, i + 1).x));
+			float32x4_t b = vcombine_f32(vld1_f32(&positionAt(points, i + 1).x), vld1_f32(&positionAt(points, i + 2).x));
+			a = vsubq_f32(a, o);
+			b = vsubq_f32(b, o);
+
+			acc = vaddq_f32(acc, vmulq_f32(a, vrev64q_f32(b)));
+		}
+
+		float32x4_t diff = vsubq_f32(acc, vrev64q_f32(acc));
+		sum = vgetq_lane_f32(diff, 0) + vgetq_lane_f32(diff, 2);
+		return i;
+	}
+	static std::size_t crossSumNEON(const float* xs, const float* ys, std::size_t first, std::size_t end, const glm::vec2& origin, float& sum) noexcept {
+		const float32x4_t ox = vdupq_n_f32(origin.x), oy = vdupq_n_f32(origin.y);
+		float32x4_t acc = vdupq_n_f32(0.f);
+
+		std::size_t i = first;
+		for (; i + 4 <= end; i += 4) {
+			float32x4_t x0 = vsubq_f32(vld1q_f32(xs + i), ox), y0 = vsubq_f32(vld1q_f32(ys + i), oy);
+			float32x4_t x1 = vsubq_f32(vld1q_f32(xs + i + 1), ox), y1 = vsubq_f32(vld1q_f32(ys + i + 1), oy);
+			acc = vaddq_f32(acc, vsubq_f32(vmulq_f32(x0, y1), vmulq_f32(y0, x1)));
+		}
+
+		float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+		sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+		return i;
+	}
+#endif
+
+	float signedArea(const Contour& contour) noexcept {
+		const std::size_t count = contour.size();
+		if (count < 3) {
+			return 0.f;
+		}
+
+		const Contour::Point* points = contour.points.data();
+		const glm::vec2 origin = points[0].point;
+		const std::size_t last = count - 2;
+
+		float sum = 0.f;
+		std::size_t i = 1;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			i = crossSumSSE2(points, 1, last + 1, origin, sum);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = crossSumNEON(points, 1, last + 1, origin, sum);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i <= last; ++i) {
+			glm::vec2 u = points[i].point - origin, v = points[i + 1].point - origin;
+			sum += u.x * v.y - u.y * v.x;
+		}
+		return 0.5f * sum;
+	}
+	float signedArea(const ContourSoA& contour) noexcept {
+		const std::size_t count = contour.size();
+		if (count < 3) {
+			return 0.f;
+		}
+
+		const float* xs = contour.xs.data();
+		const float* ys = contour.ys.data();
+		const glm::vec2 origin{ xs[0], ys[0] };
+		const std::size_t last = count - 2;
+
+		float sum = 0.f;
+		std::size_t i = 1;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+			i = crossSumAVX2(xs, ys, 1, last + 1, origin, sum);
+			break;
+		case SimdLevel::SSE2:
+			i = crossSumSSE2(xs, ys, 1, last + 1, origin, sum);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = crossSumNEON(xs, ys, 1, last + 1, origin, sum);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i <= last; ++i) {
+			float ux = xs[i] - origin.x, uy = ys[i] - origin.y;
+			float vx = xs[i + 1] - origin.x, vy = ys[i + 1] - origin.y;
+			sum += ux * vy - uy * vx;
+		}
+		return 0.5f * sum;
+	}
+	float signedArea(const Outline& outline) noexcept {
 		float area = 0.f;
 		for (const Contour& contour : outline) {
-			if (contour.empty()) {
-				continue;
-			}
+			area += signedArea(contour);
+		}
+		return area;
+	}
+
+	static Orientation orientationFromArea(float area) noexcept {
+		return area <= 0.f ? Orientation::ccw : Orientation::cw;
+	}
 
-			glm::vec2 u = contour.back().point;
-			for (const Contour::Point& point : contour) {
-				glm::vec2 v = point.point;
-				area += u.x * v.y - u.y * v.x;
+	Orientation orientationOf(const Contour& contour) noexcept {
+		return orientationFromArea(signedArea(contour));
+	}
+	Orientation orientationOf(const Outline& outline) {
+		return orientationFromArea(signedArea(outline));
+	}
 
-				u = v;
+	void signedAreas(const Outline* outlines, std::size_t count, float* areas) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			areas[i] = signedArea(outlines[i]);
+		}
+	}
+	void orientationsOf(const Outline* outlines, std::size_t count, Orientation* orientations) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const Outline& outline = outlines[i];
+			if (outline.bounds.width() == 0.f || outline.bounds.height() == 0.f) {
+				orientations[i] = Orientation::ccw;
+				continue;
 			}
+			orientations[i] = orientationFromArea(signedArea(outline));
 		}
-		return area <= 0.f ? Orientation::ccw : Orientation::cw;
 	}
 }
\ No newline at end of file
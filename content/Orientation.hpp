@@ -1,6 +1,9 @@
 #pragma once
+#include <cstddef>
 
 namespace pf {
+    struct Contour;
+    struct ContourSoA;
     struct Outline;
 
     enum class Orientation {
@@ -10,5 +13,19 @@ namespace pf {
         cw = 1,
     };
 
+    // Signed area of the polygon through every point of the contour, control points included.
+    // Positive means clockwise with Y down. Closed and open contours are treated alike.
+    float signedArea(const Contour&) noexcept;
+    float signedArea(const ContourSoA&) noexcept;
+    // Sum of the signed areas of all the contours.
+    float signedArea(const Outline&) noexcept;
+
+    Orientation orientationOf(const Contour&) noexcept;
     Orientation orientationOf(const Outline&);
+
+    // Bulk versions, writing one result per outline. The outlines are independent, so disjoint
+    // ranges can be handed to different threads, for example through Executor::forEach.
+    void signedAreas(const Outline* outlines, std::size_t count, float* areas) noexcept;
+    // Skips the summation for outlines with flat bounds, which can only have zero area.
+    void orientationsOf(const Outline* outlines, std::size_t count, Orientation* orientations) noexcept;
 };
\ No newline at end of file
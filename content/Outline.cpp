@@ -1,4 +1,6 @@
 #include "Outline.hpp"
+#include "Clip.hpp"
+#include "Orientation.hpp"
 
 namespace pf {
 	Outline Outline::withCapacity(std::size_t cap) {
@@ -56,30 +58,30 @@ namespace pf {
 			return;
 		}
 
-		for (const Contour& con : other) {
-			contours.push_back(con);
-		}
-
 		if (empty()) {
 			bounds = other.bounds;
 		}
 		else {
 			bounds = bounds.merge(other.bounds);
 		}
+
+		for (const Contour& con : other) {
+			contours.push_back(con);
+		}
 	}
 	void Outline::push(const Contour& contour) {
 		if (contour.empty()) {
 			return;
 		}
 
-		contours.push_back(contour);
-
 		if (contours.empty()) {
 			bounds = contour.bounds;
 		}
 		else {
 			bounds = bounds.merge(contour.bounds);
 		}
+
+		contours.push_back(contour);
 	}
 	void Outline::push(Outline&& other) {
 		if (other.empty()) {
@@ -122,11 +124,44 @@ namespace pf {
 		return ret;
 	}
 
+	bool Outline::isOutsidePolygon(const std::vector<glm::vec2>& polygon) const noexcept {
+		return rectIsOutsidePolygon(bounds, polygon);
+	}
+
+	void Outline::clipAgainstPolygon(const std::vector<glm::vec2>& polygon) {
+		if (rectIsInsidePolygon(bounds, polygon)) {
+			return;
+		}
+
+		std::vector<Contour> input = std::move(contours);
+		clear();
+		for (const Contour& contour : input) {
+			if (rectIsInsidePolygon(contour.bounds, polygon)) {
+				push(contour);
+			}
+			else if (!rectIsOutsidePolygon(contour.bounds, polygon)) {
+				push(clipContourToPolygon(contour, polygon));
+			}
+		}
+	}
+	void Outline::clipAgainstRect(const RectF& rect) {
+		if (rect.contains(bounds)) {
+			return;
+		}
+
+		std::vector<Contour> input = std::move(contours);
+		clear();
+		for (const Contour& contour : input) {
+			push(clipContourToRect(contour, rect));
+		}
+	}
+
 	void Outline::transform(const Transform2F& form) {
 		if (form.isIdentity()) {
 			return;
 		}
 
+		// Each contour transform also recomputes that contour's bounds, so the outline bounds only need merging.
 		for (Contour& contour : contours) {
 			contour.transform(form);
 		}
@@ -142,7 +177,11 @@ namespace pf {
 		dilate({ amount, amount });
 	}
 	void Outline::dilate(const glm::vec2& amount) {
-
+		Orientation orientation = orientationOf(*this);
+		for (Contour& contour : contours) {
+			contour.dilate(amount, orientation);
+		}
+		bounds = bounds.dilate(amount);
 	}
 
 	using iterator = Outline::iterator;
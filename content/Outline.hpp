@@ -47,6 +47,14 @@ namespace pf {
 		void transform(const Transform2F& form);
 		Outline transformed(const Transform2F& form) const;
 
+		// Returns true if the bounds are obviously outside the convex polygon. Can be false even when they are.
+		bool isOutsidePolygon(const std::vector<glm::vec2>& polygon) const noexcept;
+
+		// Sutherland-Hodgman clipping, see Clip.hpp. Contours whose bounds are entirely inside or
+		// outside the clip region are kept or dropped without being walked.
+		void clipAgainstPolygon(const std::vector<glm::vec2>& polygon);
+		void clipAgainstRect(const RectF& rect);
+
 		void dilate(float amount);
 		void dilate(const glm::vec2& amount);
 
@@ -0,0 +1,251 @@
+#include "OutlineArena.hpp"
+
+#include <cassert>
+
+namespace pf {
+	std::size_t ContourView::size() const noexcept {
+		return count;
+	}
+	bool ContourView::empty() const noexcept {
+		return count == 0;
+	}
+	bool ContourView::isClosed() const noexcept {
+		return closed;
+	}
+
+	const Contour::Point& ContourView::operator[](std::size_t index) const {
+		assert(index < count);
+		return points[index];
+	}
+	bool ContourView::isEndpoint(std::size_t index) const noexcept {
+		return points[index].kind == 0;
+	}
+
+	ContourIter ContourView::iter(ContourIterFlags flags) const noexcept {
+		return ContourIter{ points, count, closed, flags };
+	}
+
+	Contour ContourView::toContour() const {
+		Contour ret;
+		ret.points.assign(points, points + count);
+		ret.bounds = bounds;
+		ret.closed = closed;
+		return ret;
+	}
+
+	ContourView::const_iterator ContourView::begin() const noexcept {
+		return points;
+	}
+	ContourView::const_iterator ContourView::end() const noexcept {
+		return points + count;
+	}
+
+	std::size_t OutlineView::size() const noexcept {
+		return contourCount;
+	}
+	bool OutlineView::empty() const noexcept {
+		return contourCount == 0;
+	}
+
+	ContourView OutlineView::operator[](std::size_t index) const {
+		assert(index < contourCount);
+		return arena->contour(firstContour + index);
+	}
+
+	ContourView OutlineView::const_iterator::operator*() const {
+		return arena->contour(index);
+	}
+	OutlineView::const_iterator& OutlineView::const_iterator::operator++() noexcept {
+		++index;
+		return *this;
+	}
+	bool OutlineView::const_iterator::operator==(const const_iterator& other) const noexcept {
+		return arena == other.arena && index == other.index;
+	}
+	bool OutlineView::const_iterator::operator!=(const const_iterator& other) const noexcept {
+		return !(*this == other);
+	}
+
+	OutlineView::const_iterator OutlineView::begin() const noexcept {
+		return const_iterator{ arena, firstContour };
+	}
+	OutlineView::const_iterator OutlineView::end() const noexcept {
+		return const_iterator{ arena, firstContour + contourCount };
+	}
+
+	Outline OutlineView::toOutline() const {
+		Outline ret = Outline::withCapacity(contourCount);
+		for (std::size_t i = 0; i < contourCount; ++i) {
+			ret.contours.push_back((*this)[i].toContour());
+		}
+		ret.bounds = bounds;
+		return ret;
+	}
+
+	OutlineArena::OutlineArena()
+		: building(false)
+	{}
+
+	void OutlineArena::reserve(std::size_t pointCap, std::size_t contourCap, std::size_t outlineCap) {
+		points.reserve(pointCap);
+		contours.reserve(contourCap);
+		outlines.reserve(outlineCap);
+	}
+
+	void OutlineArena::reset() noexcept {
+		assert(!building);
+		points.clear();
+		contours.clear();
+		outlines.clear();
+	}
+
+	std::size_t OutlineArena::size() const noexcept {
+		return outlines.size();
+	}
+	bool OutlineArena::empty() const noexcept {
+		return outlines.empty();
+	}
+
+	OutlineView OutlineArena::operator[](std::size_t index) const {
+		assert(index < outlines.size());
+		const OutlineRange& range = outlines[index];
+		return OutlineView{ this, range.firstContour, range.contourCount, range.bounds };
+	}
+	ContourView OutlineArena::contour(std::size_t index) const {
+		assert(index < contours.size());
+		const ContourRange& range = contours[index];
+		return ContourView{ points.data() + range.firstPoint, range.pointCount, range.bounds, range.closed };
+	}
+
+	std::size_t OutlineArena::push(const Outline& outline) {
+		assert(!building);
+		OutlineRange range{ contours.size(), 0, outline.bounds };
+		for (const Contour& contour : outline) {
+			contours.push_back(ContourRange{ points.size(), contour.size(), contour.bounds, contour.isClosed() });
+			points.insert(points.end(), contour.begin(), contour.end());
+		}
+		range.contourCount = contours.size() - range.firstContour;
+
+		outlines.push_back(range);
+		return outlines.size() - 1;
+	}
+
+	void OutlineArena::transform(std::size_t index, const Transform2F& form) {
+		assert(index < outlines.size());
+		assert(!building);
+		if (form.isIdentity()) {
+			return;
+		}
+
+		// Empty contours keep their bounds, so the merge starts at the first contour with points.
+		OutlineRange& outline = outlines[index];
+		bool haveBounds = false;
+		for (std::size_t i = 0; i < outline.contourCount; ++i) {
+			ContourRange& range = contours[outline.firstContour + i];
+			if (range.pointCount == 0) {
+				continue;
+			}
+
+			glm::vec2* first = &points[range.firstPoint].point;
+			range.bounds = form.applyBatchBounds(first, first, range.pointCount, sizeof(Contour::Point));
+			outline.bounds = haveBounds ? outline.bounds.merge(range.bounds) : range.bounds;
+			haveBounds = true;
+		}
+		if (!haveBounds) {
+			outline.bounds = RectF{};
+		}
+	}
+
+	OutlineBuilder::OutlineBuilder(OutlineArena& _arena)
+		: arena(&_arena)
+		, firstPoint(_arena.points.size())
+		, firstContour(_arena.contours.size())
+		, contourStart(_arena.points.size())
+		, contourBounds{}
+		, finished(false)
+	{
+		assert(!_arena.building);
+		_arena.building = true;
+	}
+	OutlineBuilder::~OutlineBuilder() {
+		if (!finished) {
+			arena->points.resize(firstPoint);
+			arena->contours.resize(firstContour);
+			arena->building = false;
+		}
+	}
+
+	void OutlineBuilder::pushPoint(const glm::vec2& p, int kind) {
+		assert(!finished);
+		std::vector<Contour::Point>& points = arena->points;
+		if (points.size() == contourStart) {
+			contourBounds = RectF::fromPoints(p, p);
+		}
+		else {
+			contourBounds = contourBounds.merge(p);
+		}
+		points.push_back(Contour::Point{ p, kind });
+	}
+	void OutlineBuilder::pushEndpoint(const glm::vec2& p) {
+		pushPoint(p, 0);
+	}
+	void OutlineBuilder::pushQuadratic(const glm::vec2& p0, const glm::vec2& p1) {
+		pushPoint(p0, 1);
+		pushPoint(p1, 0);
+	}
+	void OutlineBuilder::pushCubic(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2) {
+		pushPoint(p0, 1);
+		pushPoint(p1, 2);
+		pushPoint(p2, 0);
+	}
+	void OutlineBuilder::pushContour(const Contour& contour) {
+		assert(!finished);
+		endContour();
+		if (contour.empty()) {
+			return;
+		}
+
+		arena->points.insert(arena->points.end(), contour.begin(), contour.end());
+		contourBounds = contour.bounds;
+		if (contour.isClosed()) {
+			close();
+		}
+		else {
+			endContour();
+		}
+	}
+
+	void OutlineBuilder::close() {
+		assert(!finished);
+		if (arena->points.size() == contourStart) {
+			return;
+		}
+
+		arena->contours.push_back(OutlineArena::ContourRange{ contourStart, arena->points.size() - contourStart, contourBounds, true });
+		contourStart = arena->points.size();
+	}
+	void OutlineBuilder::endContour() {
+		assert(!finished);
+		if (arena->points.size() == contourStart) {
+			return;
+		}
+
+		arena->contours.push_back(OutlineArena::ContourRange{ contourStart, arena->points.size() - contourStart, contourBounds, false });
+		contourStart = arena->points.size();
+	}
+
+	std::size_t OutlineBuilder::finish() {
+		endContour();
+		finished = true;
+		arena->building = false;
+
+		OutlineArena::OutlineRange range{ firstContour, arena->contours.size() - firstContour, RectF{} };
+		for (std::size_t i = 0; i < range.contourCount; ++i) {
+			const RectF& bounds = arena->contours[firstContour + i].bounds;
+			range.bounds = i == 0 ? bounds : range.bounds.merge(bounds);
+		}
+
+		arena->outlines.push_back(range);
+		return arena->outlines.size() - 1;
+	}
+};
\ No newline at end of file
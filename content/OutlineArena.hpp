@@ -0,0 +1,149 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include "../geometry/Rect.hpp"
+#include "../geometry/Transform2d.hpp"
+
+#include "Contour.hpp"
+#include "Outline.hpp"
+
+namespace pf {
+	struct OutlineArena;
+
+	// Non owning view of a contour whose points live in an OutlineArena.
+	struct ContourView {
+		using const_iterator = const Contour::Point*;
+
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+		bool isClosed() const noexcept;
+
+		const Contour::Point& operator[](std::size_t index) const;
+		bool isEndpoint(std::size_t index) const noexcept;
+
+		ContourIter iter(ContourIterFlags flags = ContourIterFlags::None) const noexcept;
+
+		Contour toContour() const;
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+		const Contour::Point* points;
+		std::size_t count;
+		RectF bounds;
+		bool closed;
+	};
+
+	// Non owning view of an outline stored in an OutlineArena. Iterates like an Outline, yielding
+	// ContourViews, so code templated on the outline works with both.
+	struct OutlineView {
+		struct const_iterator {
+			ContourView operator*() const;
+			const_iterator& operator++() noexcept;
+			bool operator==(const const_iterator& other) const noexcept;
+			bool operator!=(const const_iterator& other) const noexcept;
+
+			const OutlineArena* arena;
+			std::size_t index;
+		};
+
+		// number of contours in the outline.
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+
+		ContourView operator[](std::size_t index) const;
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+		Outline toOutline() const;
+
+		const OutlineArena* arena;
+		std::size_t firstContour;
+		std::size_t contourCount;
+		RectF bounds;
+	};
+
+	// Stores the points of many outlines back to back in a single buffer, with the contours and outlines
+	// as ranges into it. Resetting keeps the capacity, so rebuilding a scene of similar size every frame
+	// stops allocating once the buffers have grown.
+	// Views handed out by the arena are invalidated by anything that pushes into it, and by reset.
+	// While an OutlineBuilder is alive it owns the end of the buffers, so it must be the only one and
+	// nothing else may push into the arena.
+	struct OutlineArena {
+		struct ContourRange {
+			std::size_t firstPoint;
+			std::size_t pointCount;
+			RectF bounds;
+			bool closed;
+		};
+		struct OutlineRange {
+			std::size_t firstContour;
+			std::size_t contourCount;
+			RectF bounds;
+		};
+
+		OutlineArena(const OutlineArena&) = default;
+		OutlineArena(OutlineArena&&) noexcept = default;
+		OutlineArena& operator=(const OutlineArena&) = default;
+		OutlineArena& operator=(OutlineArena&&) noexcept = default;
+		~OutlineArena() = default;
+
+		OutlineArena();
+
+		void reserve(std::size_t pointCap, std::size_t contourCap, std::size_t outlineCap);
+
+		// Forgets every outline, but keeps the memory for the next build.
+		void reset() noexcept;
+
+		// number of outlines in the arena.
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+
+		OutlineView operator[](std::size_t index) const;
+		ContourView contour(std::size_t index) const;
+
+		// Copies an outline into the arena, returning its index.
+		std::size_t push(const Outline& outline);
+
+		void transform(std::size_t index, const Transform2F& form);
+
+		std::vector<Contour::Point> points;
+		std::vector<ContourRange> contours;
+		std::vector<OutlineRange> outlines;
+		// Set while an OutlineBuilder appends to the arena.
+		bool building;
+	};
+
+	// Appends a single outline to an arena, contour by contour.
+	// Dropping the builder without calling finish leaves the arena as it was.
+	struct OutlineBuilder {
+		OutlineBuilder(const OutlineBuilder&) = delete;
+		OutlineBuilder& operator=(const OutlineBuilder&) = delete;
+		~OutlineBuilder();
+
+		OutlineBuilder(OutlineArena& _arena);
+
+		void pushPoint(const glm::vec2& p, int kind);
+		void pushEndpoint(const glm::vec2& p);
+		void pushQuadratic(const glm::vec2& p0, const glm::vec2& p1);
+		void pushCubic(const glm::vec2& p0, const glm::vec2& p1, const glm::vec2& p2);
+		void pushContour(const Contour& contour);
+
+		// Closes the current contour and starts a new one.
+		void close();
+		// Ends the current contour, leaving it open.
+		void endContour();
+
+		// Commits the outline, returning its index in the arena.
+		std::size_t finish();
+	private:
+		OutlineArena* arena;
+		std::size_t firstPoint, firstContour;
+		std::size_t contourStart;
+		RectF contourBounds;
+		bool finished;
+	};
+};
\ No newline at end of file
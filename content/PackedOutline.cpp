@@ -0,0 +1,207 @@
+#include "PackedOutline.hpp"
+#include "Hash.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <limits>
+
+namespace pf {
+	static_assert(sizeof(PackedOutline::ContourEntry) % alignof(Contour::Point) == 0, "points must stay aligned after the contour entries");
+
+	PackedOutline PackedOutline::fromOutline(const Outline& outline) {
+		std::size_t pointCount = 0;
+		for (const Contour& contour : outline) {
+			pointCount += contour.size();
+		}
+
+		PackedOutline ret = allocate(outline.size(), pointCount);
+		ContourEntry* entries = ret.mutableContours();
+		Contour::Point* points = ret.mutablePoints();
+
+		uint32_t first = 0;
+		for (const Contour& contour : outline) {
+			assert(contour.size() <= std::numeric_limits<uint32_t>::max());
+			uint32_t count = static_cast<uint32_t>(contour.size());
+			*entries++ = ContourEntry{ first, count, contour.bounds, contour.isClosed() ? 1u : 0u };
+			// An empty contour may have no storage at all.
+			if (count > 0) {
+				std::memcpy(points + first, contour.points.data(), count * sizeof(Contour::Point));
+			}
+			first += count;
+		}
+
+		ret.finish(outline.bounds);
+		return ret;
+	}
+	PackedOutline PackedOutline::fromOutline(const OutlineView& outline) {
+		std::size_t pointCount = 0;
+		for (std::size_t i = 0; i < outline.size(); ++i) {
+			pointCount += outline[i].size();
+		}
+
+		PackedOutline ret = allocate(outline.size(), pointCount);
+		ContourEntry* entries = ret.mutableContours();
+		Contour::Point* points = ret.mutablePoints();
+
+		uint32_t first = 0;
+		for (std::size_t i = 0; i < outline.size(); ++i) {
+			ContourView contour = outline[i];
+			assert(contour.size() <= std::numeric_limits<uint32_t>::max());
+			uint32_t count = static_cast<uint32_t>(contour.size());
+			*entries++ = ContourEntry{ first, count, contour.bounds, contour.isClosed() ? 1u : 0u };
+			if (count > 0) {
+				std::memcpy(points + first, contour.points, count * sizeof(Contour::Point));
+			}
+			first += count;
+		}
+
+		ret.finish(outline.bounds);
+		return ret;
+	}
+
+	PackedOutline::PackedOutline(const PackedOutline& other) noexcept
+		: header(other.header)
+	{
+		if (header) {
+			header->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	PackedOutline::PackedOutline(PackedOutline&& other) noexcept
+		: header(other.header)
+	{
+		other.header = nullptr;
+	}
+	PackedOutline& PackedOutline::operator=(const PackedOutline& other) noexcept {
+		if (header != other.header) {
+			if (other.header) {
+				other.header->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+			release();
+			header = other.header;
+		}
+		return *this;
+	}
+	PackedOutline& PackedOutline::operator=(PackedOutline&& other) noexcept {
+		if (this != &other) {
+			release();
+			header = other.header;
+			other.header = nullptr;
+		}
+		return *this;
+	}
+	PackedOutline::~PackedOutline() {
+		release();
+	}
+
+	PackedOutline::PackedOutline() noexcept
+		: header(nullptr)
+	{}
+
+	Outline PackedOutline::toOutline() const {
+		Outline ret = Outline::withCapacity(size());
+		const Contour::Point* allPoints = points();
+		for (std::size_t i = 0, count = size(); i < count; ++i) {
+			const ContourEntry& entry = contours()[i];
+
+			Contour contour;
+			contour.points.assign(allPoints + entry.firstPoint, allPoints + entry.firstPoint + entry.pointCount);
+			contour.bounds = entry.bounds;
+			contour.closed = entry.closed != 0;
+			ret.contours.push_back(std::move(contour));
+		}
+		ret.bounds = bounds();
+		return ret;
+	}
+
+	std::size_t PackedOutline::size() const noexcept {
+		return header ? header->contourCount : 0;
+	}
+	bool PackedOutline::empty() const noexcept {
+		return size() == 0;
+	}
+	std::size_t PackedOutline::pointCount() const noexcept {
+		return header ? header->pointCount : 0;
+	}
+
+	RectF PackedOutline::bounds() const noexcept {
+		return header ? header->bounds : RectF{};
+	}
+	std::size_t PackedOutline::hash() const noexcept {
+		return header ? header->hash : static_cast<std::size_t>(hashBytes(nullptr, 0));
+	}
+
+	ContourView PackedOutline::operator[](std::size_t index) const {
+		assert(index < size());
+		const ContourEntry& entry = contours()[index];
+		return ContourView{ points() + entry.firstPoint, entry.pointCount, entry.bounds, entry.closed != 0 };
+	}
+
+	const PackedOutline::ContourEntry* PackedOutline::contours() const noexcept {
+		return static_cast<const ContourEntry*>(data());
+	}
+	const Contour::Point* PackedOutline::points() const noexcept {
+		return reinterpret_cast<const Contour::Point*>(contours() + size());
+	}
+
+	const void* PackedOutline::data() const noexcept {
+		if (!header) {
+			return nullptr;
+		}
+		return reinterpret_cast<const char*>(header) + headerSize();
+	}
+	std::size_t PackedOutline::byteSize() const noexcept {
+		return size() * sizeof(ContourEntry) + pointCount() * sizeof(Contour::Point);
+	}
+
+	bool PackedOutline::operator==(const PackedOutline& other) const noexcept {
+		if (header == other.header) {
+			return true;
+		}
+		if (hash() != other.hash() || size() != other.size() || pointCount() != other.pointCount()) {
+			return false;
+		}
+		return std::memcmp(data(), other.data(), byteSize()) == 0;
+	}
+	bool PackedOutline::operator!=(const PackedOutline& other) const noexcept {
+		return !(*this == other);
+	}
+
+	std::size_t PackedOutline::headerSize() noexcept {
+		// Round up so the contour entries that follow the header stay aligned.
+		constexpr std::size_t align = alignof(std::max_align_t);
+		return (sizeof(Header) + align - 1) / align * align;
+	}
+	PackedOutline PackedOutline::allocate(std::size_t contourCount, std::size_t pointCount) {
+		PackedOutline ret;
+		if (contourCount == 0) {
+			return ret;
+		}
+		// The entries index the points with 32 bits.
+		assert(contourCount <= std::numeric_limits<uint32_t>::max() && pointCount <= std::numeric_limits<uint32_t>::max());
+
+		std::size_t bytes = headerSize() + contourCount * sizeof(ContourEntry) + pointCount * sizeof(Contour::Point);
+		void* memory = ::operator new(bytes);
+		ret.header = new (memory) Header{ {1}, static_cast<uint32_t>(contourCount), static_cast<uint32_t>(pointCount), RectF{}, 0 };
+		return ret;
+	}
+	void PackedOutline::finish(const RectF& bounds) noexcept {
+		if (header) {
+			header->bounds = bounds;
+			header->hash = static_cast<std::size_t>(hashBytes(data(), byteSize()));
+		}
+	}
+	PackedOutline::ContourEntry* PackedOutline::mutableContours() noexcept {
+		return const_cast<ContourEntry*>(contours());
+	}
+	Contour::Point* PackedOutline::mutablePoints() noexcept {
+		return const_cast<Contour::Point*>(points());
+	}
+	void PackedOutline::release() noexcept {
+		if (header && header->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			header->~Header();
+			::operator delete(header);
+		}
+		header = nullptr;
+	}
+};
\ No newline at end of file
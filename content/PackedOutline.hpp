@@ -0,0 +1,84 @@
+#pragma once
+#include <cinttypes>
+#include <atomic>
+#include <functional>
+
+#include "../geometry/Rect.hpp"
+
+#include "Contour.hpp"
+#include "Outline.hpp"
+#include "OutlineArena.hpp"
+
+namespace pf {
+	// Immutable outline stored in a single allocation: a header, one entry per contour, then every point.
+	// Copies share the allocation through an atomic reference count, so they are cheap and safe to hand
+	// between threads. The hash is computed once when packing.
+	struct PackedOutline {
+		struct ContourEntry {
+			uint32_t firstPoint;
+			uint32_t pointCount;
+			RectF bounds;
+			uint32_t closed;
+		};
+
+		static PackedOutline fromOutline(const Outline& outline);
+		static PackedOutline fromOutline(const OutlineView& outline);
+
+		PackedOutline(const PackedOutline& other) noexcept;
+		PackedOutline(PackedOutline&& other) noexcept;
+		PackedOutline& operator=(const PackedOutline& other) noexcept;
+		PackedOutline& operator=(PackedOutline&& other) noexcept;
+		~PackedOutline();
+
+		PackedOutline() noexcept;
+
+		Outline toOutline() const;
+
+		// number of contours in the outline.
+		std::size_t size() const noexcept;
+		bool empty() const noexcept;
+		std::size_t pointCount() const noexcept;
+
+		RectF bounds() const noexcept;
+		std::size_t hash() const noexcept;
+
+		ContourView operator[](std::size_t index) const;
+
+		const ContourEntry* contours() const noexcept;
+		const Contour::Point* points() const noexcept;
+
+		// The contour entries and points, laid out back to back, ready to be copied into a GPU buffer.
+		const void* data() const noexcept;
+		std::size_t byteSize() const noexcept;
+
+		// Compares the packed bytes, so -0 and 0 are different points here.
+		bool operator==(const PackedOutline& other) const noexcept;
+		bool operator!=(const PackedOutline& other) const noexcept;
+	private:
+		struct Header {
+			std::atomic<uint32_t> refs;
+			uint32_t contourCount;
+			uint32_t pointCount;
+			RectF bounds;
+			std::size_t hash;
+		};
+
+		static std::size_t headerSize() noexcept;
+		static PackedOutline allocate(std::size_t contourCount, std::size_t pointCount);
+		void finish(const RectF& bounds) noexcept;
+		ContourEntry* mutableContours() noexcept;
+		Contour::Point* mutablePoints() noexcept;
+		void release() noexcept;
+
+		Header* header;
+	};
+};
+
+namespace std {
+	template<>
+	struct hash<pf::PackedOutline> {
+		std::size_t operator()(pf::PackedOutline const& val) const noexcept {
+			return val.hash();
+		}
+	};
+};
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "Pattern.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace pf {
+	bool ImageHash::operator==(const ImageHash& other) const noexcept {
+		return value == other.value;
+	}
+	bool ImageHash::operator!=(const ImageHash& other) const noexcept {
+		return value != other.value;
+	}
+
+	static const std::shared_ptr<const std::vector<ColorU>>& emptyPixels() {
+		static const std::shared_ptr<const std::vector<ColorU>> empty = std::make_shared<const std::vector<ColorU>>();
+		return empty;
+	}
+
+	Image::Image() noexcept
+		: Image(glm::ivec2{ 0 }, emptyPixels())
+	{}
+	Image::Image(const glm::ivec2& _size, std::vector<ColorU> _pixels)
+		: Image(_size, std::make_shared<const std::vector<ColorU>>(std::move(_pixels)))
+	{}
+	Image::Image(const glm::ivec2& _size, std::shared_ptr<const std::vector<ColorU>> _pixels)
+		: imageSize(_size)
+		, pixelData(std::move(_pixels))
+	{
+		assert(pixelData);
+		assert(static_cast<std::size_t>(imageSize.x) * imageSize.y == pixelData->size());
+		static_assert(sizeof(ColorU) == 4, "Pixels are hashed as packed RGBA8");
+
+		const std::vector<ColorU>& pixels = *pixelData;
+		uint64_t seed = (static_cast<uint64_t>(static_cast<uint32_t>(imageSize.x)) << 32) | static_cast<uint32_t>(imageSize.y);
+		pixelsHash = ImageHash{ hashBytes(pixels.data(), pixels.size() * sizeof(ColorU), seed) };
+		opaque = std::all_of(pixels.begin(), pixels.end(), [](const ColorU& pixel) {
+			return pixel.is_opaque();
+		});
+	}
+
+	const glm::ivec2& Image::size() const noexcept {
+		return imageSize;
+	}
+	const std::vector<ColorU>& Image::pixels() const noexcept {
+		return *pixelData;
+	}
+	const std::shared_ptr<const std::vector<ColorU>>& Image::sharedPixels() const noexcept {
+		return pixelData;
+	}
+	ImageHash Image::hash() const noexcept {
+		return pixelsHash;
+	}
+	bool Image::isOpaque() const noexcept {
+		return opaque;
+	}
+
+	bool Image::operator==(const Image& other) const noexcept {
+		if (pixelsHash != other.pixelsHash || imageSize != other.imageSize) {
+			return false;
+		}
+		return pixelData == other.pixelData || *pixelData == *other.pixelData;
+	}
+	bool Image::operator!=(const Image& other) const noexcept {
+		return !(*this == other);
+	}
+
+	bool RenderTargetId::operator==(const RenderTargetId& other) const noexcept {
+		return scene == other.scene && renderTarget == other.renderTarget;
+	}
+	bool RenderTargetId::operator!=(const RenderTargetId& other) const noexcept {
+		return !(*this == other);
+	}
+
+	bool contains(PatternFlags lh, PatternFlags rh) noexcept {
+		return (lh & rh) == rh;
+	}
+
+	bool PatternSource::isOpaque() const noexcept {
+		// Render targets could be checked more cleverly, but are assumed translucent for now.
+		return kind == Kind::Image && image.isOpaque();
+	}
+
+	Pattern::Pattern(const PatternSource& _source)
+		: source(_source)
+		, transform()
+		, flags(PatternFlags::None)
+	{}
+
+	Pattern Pattern::fromImage(const Image& image) {
+		return Pattern{ PatternSource{ PatternSource::Image, image, RenderTargetId{ 0, 0 }, image.size() } };
+	}
+	Pattern Pattern::fromRenderTarget(const RenderTargetId& id, const glm::ivec2& size) {
+		return Pattern{ PatternSource{ PatternSource::RenderTarget, Image{}, id, size } };
+	}
+
+	glm::ivec2 Pattern::size() const noexcept {
+		return source.size;
+	}
+	bool Pattern::isOpaque() const noexcept {
+		return source.isOpaque();
+	}
+
+	void Pattern::applyTransform(const Transform2F& form) noexcept {
+		transform = form.apply(transform);
+	}
+
+	void Pattern::setFlag(PatternFlags flag, bool value) noexcept {
+		flags = value ? (flags | flag) : (flags & ~flag);
+	}
+
+	bool Pattern::repeatX() const noexcept {
+		return contains(flags, PatternFlags::RepeatX);
+	}
+	void Pattern::setRepeatX(bool repeat) noexcept {
+		setFlag(PatternFlags::RepeatX, repeat);
+	}
+	bool Pattern::repeatY() const noexcept {
+		return contains(flags, PatternFlags::RepeatY);
+	}
+	void Pattern::setRepeatY(bool repeat) noexcept {
+		setFlag(PatternFlags::RepeatY, repeat);
+	}
+	bool Pattern::smoothingEnabled() const noexcept {
+		return !contains(flags, PatternFlags::NoSmoothing);
+	}
+	void Pattern::setSmoothingEnabled(bool enable) noexcept {
+		setFlag(PatternFlags::NoSmoothing, !enable);
+	}
+
+	ImageRegistry::ImageRegistry()
+		: uploaded(0)
+	{}
+
+	std::optional<uint32_t> ImageRegistry::find(const Image& image) const {
+		auto range = byHash.equal_range(image.hash().value);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (images[it->second] == image) {
+				return it->second;
+			}
+		}
+		return std::nullopt;
+	}
+
+	uint32_t ImageRegistry::intern(const Image& image) {
+		if (std::optional<uint32_t> existing = find(image)) {
+			return *existing;
+		}
+
+		uint32_t id = static_cast<uint32_t>(images.size());
+		images.push_back(image);
+		byHash.emplace(image.hash().value, id);
+		return id;
+	}
+
+	const Image& ImageRegistry::get(uint32_t id) const {
+		assert(id < images.size());
+		return images[id];
+	}
+	std::size_t ImageRegistry::size() const noexcept {
+		return images.size();
+	}
+
+	uint32_t ImageRegistry::uploadedCount() const noexcept {
+		return uploaded;
+	}
+	void ImageRegistry::markAllUploaded() noexcept {
+		uploaded = static_cast<uint32_t>(images.size());
+	}
+
+	void ImageRegistry::clear() {
+		images.clear();
+		byHash.clear();
+		uploaded = 0;
+	}
+};
+
+pf::PatternFlags operator|(pf::PatternFlags lh, pf::PatternFlags rh) noexcept {
+	return static_cast<pf::PatternFlags>(
+		static_cast<int>(lh) | static_cast<int>(rh)
+		);
+}
+pf::PatternFlags operator&(pf::PatternFlags lh, pf::PatternFlags rh) noexcept {
+	return static_cast<pf::PatternFlags>(
+		static_cast<int>(lh) & static_cast<int>(rh)
+		);
+}
+pf::PatternFlags operator~(pf::PatternFlags lh) noexcept {
+	return static_cast<pf::PatternFlags>(
+		~static_cast<int>(lh)
+		);
+}
\ No newline at end of file
@@ -1,5 +1,144 @@
 #pragma once
+#include <cinttypes>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include <glm/vec2.hpp>
+
+#include "../color/color.hpp"
+#include "../geometry/Transform2d.hpp"
+
+#include "Hash.hpp"
 
 namespace pf {
+	struct ImageHash {
+		uint64_t value;
+
+		bool operator==(const ImageHash& other) const noexcept;
+		bool operator!=(const ImageHash& other) const noexcept;
+	};
+
+	// An immutable RGBA8 image, linear color space, not premultiplied. Copies share the pixels, and the
+	// content hash is computed once on construction.
+	struct Image {
+		Image() noexcept;
+		Image(const glm::ivec2& _size, std::vector<ColorU> _pixels);
+		Image(const glm::ivec2& _size, std::shared_ptr<const std::vector<ColorU>> _pixels);
+
+		const glm::ivec2& size() const noexcept;
+		const std::vector<ColorU>& pixels() const noexcept;
+		const std::shared_ptr<const std::vector<ColorU>>& sharedPixels() const noexcept;
+
+		// Covers the size and the pixels, so equal images always hash the same.
+		ImageHash hash() const noexcept;
+		bool isOpaque() const noexcept;
+
+		// Compares the hashes first, then the pixels unless they are shared.
+		bool operator==(const Image& other) const noexcept;
+		bool operator!=(const Image& other) const noexcept;
+	private:
+		glm::ivec2 imageSize;
+		std::shared_ptr<const std::vector<ColorU>> pixelData;
+		ImageHash pixelsHash;
+		bool opaque;
+	};
+
+	struct RenderTargetId {
+		// The scene this render target belongs to.
+		uint32_t scene;
+		// The render target within its scene.
+		uint32_t renderTarget;
+
+		bool operator==(const RenderTargetId& other) const noexcept;
+		bool operator!=(const RenderTargetId& other) const noexcept;
+	};
+
+	enum class PatternFlags : uint8_t {
+		None = 0,
+		/// Repeat along x, instead of using the base color outside of the image.
+		RepeatX = 1,
+		/// Repeat along y, instead of using the base color outside of the image.
+		RepeatY = 1 << 1,
+		/// Sample with nearest neighbor filtering instead of bilinear.
+		NoSmoothing = 1 << 2,
+	};
+
+	bool contains(PatternFlags lh, PatternFlags rh) noexcept;
+
+	struct PatternSource {
+		enum class Kind {
+			Image,
+			RenderTarget,
+		};
+		static constexpr Kind
+			Image = Kind::Image,
+			RenderTarget = Kind::RenderTarget;
+
+		Kind kind;
+		// Image only.
+		pf::Image image;
+		// Render target only, the target and its size in device pixels.
+		RenderTargetId renderTarget;
+		glm::ivec2 size;
+
+		bool isOpaque() const noexcept;
+	};
+
+	struct Pattern {
+		static Pattern fromImage(const Image& image);
+		static Pattern fromRenderTarget(const RenderTargetId& id, const glm::ivec2& size);
+
+		// Size in pixels, not taking the transform into account.
+		glm::ivec2 size() const noexcept;
+		// A best effort check, it may return false for patterns that happen to be opaque.
+		bool isOpaque() const noexcept;
+
+		// Applied after the existing transform.
+		void applyTransform(const Transform2F& form) noexcept;
+
+		bool repeatX() const noexcept;
+		void setRepeatX(bool repeat) noexcept;
+		bool repeatY() const noexcept;
+		void setRepeatY(bool repeat) noexcept;
+		bool smoothingEnabled() const noexcept;
+		void setSmoothingEnabled(bool enable) noexcept;
+
+		PatternSource source;
+		Transform2F transform;
+		PatternFlags flags;
+	private:
+		Pattern(const PatternSource& _source);
+
+		void setFlag(PatternFlags flag, bool value) noexcept;
+	};
+
+	// Interns images by content, so an image referenced by any number of paths is stored and uploaded
+	// once. Ids are dense and never reused, which lets the images added since the last upload be
+	// found without any extra bookkeeping.
+	struct ImageRegistry {
+		ImageRegistry();
+
+		// The id of the registered image with the same contents, registering image if there is none.
+		uint32_t intern(const Image& image);
+		std::optional<uint32_t> find(const Image& image) const;
+
+		const Image& get(uint32_t id) const;
+		std::size_t size() const noexcept;
+
+		// The ids added since the last call to markAllUploaded are [uploadedCount(), size()).
+		uint32_t uploadedCount() const noexcept;
+		void markAllUploaded() noexcept;
+
+		void clear();
+	private:
+		std::vector<Image> images;
+		std::unordered_multimap<uint64_t, uint32_t> byHash;
+		uint32_t uploaded;
+	};
+};
 
-};
\ No newline at end of file
+pf::PatternFlags operator|(pf::PatternFlags lh, pf::PatternFlags rh) noexcept;
+pf::PatternFlags operator&(pf::PatternFlags lh, pf::PatternFlags rh) noexcept;
+pf::PatternFlags operator~(pf::PatternFlags lh) noexcept;
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include <glm/gtx/compatibility.hpp>
 #include <glm/gtx/projection.hpp>
@@ -61,7 +62,7 @@ namespace pf {
 		constexpr float os = 1.f / 6.f, ft = 4.f / 3.f;
 		glm::vec2 p0{ 0.5f * root2 };
 		glm::vec2 p1{-root2 * os + ft, 7.f * root2 * os - ft};
-		return Segment::cubic(p0, glm::vec2{ p1.x, -p1.y }, p1, glm::vec2{p0.x, -p0.y});
+		return Segment::cubic(glm::vec2{ p0.x, -p0.y }, glm::vec2{ p1.x, -p1.y }, p1, p0);
 	}
 	Segment Segment::arc(float angle) noexcept {
 		return Segment::arcFromCos(std::cos(angle));
@@ -76,7 +77,7 @@ namespace pf {
 		}
 
 		glm::vec4 term{cosAngle, -cosAngle, cosAngle, - cosAngle};
-		glm::vec4 signs{1, -1, 1, -1};
+		glm::vec4 signs{1, -1, 1, 1};
 		glm::vec4 p3p0 = glm::sqrt((1.f + term) * 0.5f) * signs;
 		float p0x = p3p0.z, p0y = p3p0.w;
 		float p1x = (4.f - p0x), p1y = (1.f - p0x) * (3.f - p0x) / p0y;
@@ -115,10 +116,7 @@ namespace pf {
 	// Returns this segment with control points reversed.
 	Segment Segment::reversed() const noexcept {
 		Segment seg = *this;
-		auto write = seg.begin();
-		for (auto it = rbegin(), last = rend(); it != last; ++it) {
-			*write = *it;
-		}
+		std::reverse(seg.begin(), seg.begin() + size());
 		return seg;
 	}
 	std::array<Segment, 2> Segment::split(float t) const noexcept {
@@ -144,7 +142,7 @@ namespace pf {
 
 			glm::vec2 mp = glm::lerp(p3, p4, t);
 
-			return { Segment{points[0], p0, p3, mp}, Segment{mp, p2, p4, points[3]} };
+			return { Segment{points[0], p0, p3, mp}, Segment{mp, p4, p2, points[3]} };
 		}
 		default:
 			return {};
@@ -190,9 +188,9 @@ namespace pf {
 		case SegmentKind::Quadratic:
 			return Segment{
 				points[0],
-				glm::lerp(points[0], points[1], 1.f / 3.f),
-				glm::lerp(points[3], points[2], 1.f / 3.f),
-				points[3]
+				glm::lerp(points[0], points[1], 2.f / 3.f),
+				glm::lerp(points[2], points[1], 2.f / 3.f),
+				points[2]
 			};
 		case SegmentKind::Cubic:
 			return *this;
@@ -211,6 +209,7 @@ namespace pf {
 		auto write = copy.begin();
 		for (const glm::vec2 & point : *this) {
 			*write = form.apply(point);
+			++write;
 		}
 		return copy;
 	}
@@ -293,23 +292,50 @@ namespace pf {
 			return false;
 		case SegmentKind::Line:
 			return true;
-		case SegmentKind::Quadratic: {
-			glm::vec2 u = points[1] - points[0];
-			glm::vec2 v = points[2] - points[1];
-			float det = u.x * v.y - u.y * v.x;
-
-			return std::abs(det) < tolerance;
-		}
+		case SegmentKind::Quadratic:
+			return toCubic().isFlat(tolerance);
 		case SegmentKind::Cubic: {
-			glm::vec2 u = points[1] - points[0];
-			glm::vec2 v = points[2] - points[1];
-			glm::vec2 w = points[3] - points[2];
-			float det = std::abs(u.x * v.y - u.y * v.x);
-			det += std::abs(u.x * w.y - u.y * w.x);
-			return det < tolerance;
+			// Kaspar Fischer, "Piecewise Linear Approximation of Bezier Curves", 2000.
+			glm::vec2 u = points[1] * 3.f - points[0] * 2.f - points[3];
+			glm::vec2 v = points[2] * 3.f - points[3] * 2.f - points[0];
+			u *= u;
+			v *= v;
+			glm::vec2 dist = glm::max(u, v);
+			return dist.x + dist.y <= 16.f * tolerance * tolerance;
 		}
 		}
+		return false;
 	}
+	// Bounds the number of lines for degenerate input, such as huge or non finite coordinates.
+	static constexpr std::size_t MaxFlattenCount = 1 << 16;
+
+	std::size_t Segment::flattenCount(float tolerance) const noexcept {
+		assert(tolerance > 0.f);
+
+		// Wang's formula: n = sqrt(d * (d - 1) / 8 * max |second difference| / tolerance).
+		float dd = 0.f;
+		switch (kind) {
+		case SegmentKind::None:
+			return 0;
+		case SegmentKind::Line:
+			return 1;
+		case SegmentKind::Quadratic:
+			dd = 0.25f * glm::length(points[0] - points[1] * 2.f + points[2]);
+			break;
+		case SegmentKind::Cubic:
+			dd = 0.75f * std::max(
+				glm::length(points[0] - points[1] * 2.f + points[2]),
+				glm::length(points[1] - points[2] * 2.f + points[3]));
+			break;
+		}
+
+		float count = std::ceil(std::sqrt(dd / tolerance));
+		if (!(count < static_cast<float>(MaxFlattenCount))) {
+			return MaxFlattenCount;
+		}
+		return std::max(std::size_t(1), static_cast<std::size_t>(count));
+	}
+
 	float Segment::minX() const noexcept {
 		switch (kind) {
 		case SegmentKind::None:
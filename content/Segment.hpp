@@ -65,6 +65,14 @@ namespace pf {
 		Segment transform(const Transform2F& form) const noexcept;
 
 		bool isFlat(float tolerance) const noexcept;
+
+		// The number of lines needed to stay within tolerance of the curve, computed with Wang's
+		// formula. This is exact for quadratics, whose second derivative is constant.
+		std::size_t flattenCount(float tolerance) const noexcept;
+
+		// Writes flattenCount(tolerance) lines approximating this segment to out.
+		template<typename OutputIt>
+		OutputIt flatten(float tolerance, OutputIt out) const;
 		float minX() const noexcept;
 		float minY() const noexcept;
 		float maxX() const noexcept;
@@ -100,4 +108,24 @@ namespace pf {
 		SegmentKind kind;
 		SegmentFlags flags;
 	};
+
+	template<typename OutputIt>
+	OutputIt Segment::flatten(float tolerance, OutputIt out) const {
+		std::size_t count = flattenCount(tolerance);
+		if (count == 0) {
+			return out;
+		}
+
+		glm::vec2 from = points[0];
+		float step = 1.f / static_cast<float>(count);
+		for (std::size_t i = 1; i < count; ++i) {
+			glm::vec2 to = sample(static_cast<float>(i) * step);
+			*out = LineSegment2F{ from, to };
+			++out;
+			from = to;
+		}
+		*out = LineSegment2F{ from, back() };
+		++out;
+		return out;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "Stroke.hpp"
+#include "../geometry/Util.hpp"
+
+#include <cassert>
+#include <cmath>
+
+#include <glm/gtx/compatibility.hpp>
+
+namespace pf {
+	// Offsetting by control polygon is exact for lines and close for gentle curves. Segments that
+	// bend too much are split in half, but never more than this many times.
+	static constexpr int MaxOffsetDepth = 8;
+	static constexpr int OffsetSampleCount = 8;
+
+	static glm::vec2 intersectOrMidpoint(const LineSegment2F& s0, const LineSegment2F& s1) noexcept {
+		std::optional<float> t = s0.intersect(s1);
+		if (t) {
+			return s0.sample(*t);
+		}
+		return glm::lerp(s0.to(), s1.from(), 0.5f);
+	}
+
+	// Tiller-Hanson: offset each leg of the control polygon, and use the intersections of
+	// neighbouring legs as the new control points.
+	static Segment offsetOnce(const Segment& seg, float distance) noexcept {
+		const auto& p = seg.points;
+		switch (seg.kind) {
+		case SegmentKind::Line:
+			return Segment::line(LineSegment2F{ p[0], p[1] }.offset(distance));
+		case SegmentKind::Quadratic: {
+			LineSegment2F s0 = LineSegment2F{ p[0], p[1] }.offset(distance);
+			LineSegment2F s1 = LineSegment2F{ p[1], p[2] }.offset(distance);
+			return Segment::quadratic(s0.from(), intersectOrMidpoint(s0, s1), s1.to());
+		}
+		case SegmentKind::Cubic: {
+			// A control point sitting on an endpoint leaves a zero length leg, which cannot be offset.
+			if (p[0] == p[1]) {
+				LineSegment2F s0 = LineSegment2F{ p[0], p[2] }.offset(distance);
+				LineSegment2F s1 = LineSegment2F{ p[2], p[3] }.offset(distance);
+				return Segment::cubic(s0.from(), s0.from(), intersectOrMidpoint(s0, s1), s1.to());
+			}
+			if (p[2] == p[3]) {
+				LineSegment2F s0 = LineSegment2F{ p[0], p[1] }.offset(distance);
+				LineSegment2F s1 = LineSegment2F{ p[1], p[3] }.offset(distance);
+				return Segment::cubic(s0.from(), intersectOrMidpoint(s0, s1), s1.to(), s1.to());
+			}
+
+			LineSegment2F s0 = LineSegment2F{ p[0], p[1] }.offset(distance);
+			LineSegment2F s1 = LineSegment2F{ p[1], p[2] }.offset(distance);
+			LineSegment2F s2 = LineSegment2F{ p[2], p[3] }.offset(distance);
+			std::optional<float> t0 = s0.intersect(s1), t1 = s1.intersect(s2);
+			if (t0 && t1) {
+				return Segment::cubic(s0.from(), s0.sample(*t0), s1.sample(*t1), s2.to());
+			}
+			return Segment::cubic(s0.from(), glm::lerp(s0.to(), s1.from(), 0.5f), glm::lerp(s1.to(), s2.from(), 0.5f), s2.to());
+		}
+		default:
+			return seg;
+		}
+	}
+
+	static glm::vec2 derivative(const Segment& seg, float t) noexcept {
+		const auto& p = seg.points;
+		switch (seg.kind) {
+		case SegmentKind::Line:
+			return p[1] - p[0];
+		case SegmentKind::Quadratic:
+			return 2.f * glm::lerp(p[1] - p[0], p[2] - p[1], t);
+		case SegmentKind::Cubic: {
+			glm::vec2 d0 = p[1] - p[0], d1 = p[2] - p[1], d2 = p[3] - p[2];
+			return 3.f * glm::lerp(glm::lerp(d0, d1, t), glm::lerp(d1, d2, t), t);
+		}
+		default:
+			return glm::vec2{ 0.f };
+		}
+	}
+
+	static bool mightNeedJoin(const Contour& contour, LineJoin join) noexcept {
+		return contour.size() >= 2 && join != LineJoin::Bevel;
+	}
+
+	StrokeStyle::StrokeStyle() noexcept
+		: lineWidth(1.f)
+		, lineCap(LineCap::Butt)
+		, lineJoin(LineJoin::Miter)
+		, miterLimit(10.f)
+	{}
+	StrokeStyle::StrokeStyle(float _lineWidth, LineCap _lineCap, LineJoin _lineJoin, float _miterLimit) noexcept
+		: lineWidth(_lineWidth)
+		, lineCap(_lineCap)
+		, lineJoin(_lineJoin)
+		, miterLimit(_miterLimit)
+	{}
+
+	OutlineStrokeToFill::OutlineStrokeToFill(const Outline& _input, const StrokeStyle& _style, float _tolerance)
+		: input(&_input)
+		, style(_style)
+		, tolerance(_tolerance)
+	{}
+
+	void OutlineStrokeToFill::offset() {
+		output.clear();
+		output.contours.reserve(input->size() * 2);
+
+		// The radius is negated so that round caps come out clockwise.
+		const float distance = -style.lineWidth * 0.5f;
+
+		for (const Contour& source : *input) {
+			bool closed = source.isClosed();
+
+			segments.clear();
+			for (ContourIter iter = source.iter(); !iter.done();) {
+				segments.push_back(iter.next());
+			}
+
+			Contour contour = Contour::withCapacity(source.size() * 2 + 8);
+			for (std::size_t i = 0; i < segments.size(); ++i) {
+				offsetSegment(segments[i], distance, i == 0 ? LineJoin::Bevel : style.lineJoin, contour, 0);
+			}
+
+			if (closed) {
+				pushStrokedContour(std::move(contour), source, true);
+				contour = Contour::withCapacity(source.size() * 2 + 8);
+			}
+			else {
+				addCap(contour);
+			}
+
+			for (std::size_t i = 0; i < segments.size(); ++i) {
+				const Segment& segment = segments[segments.size() - 1 - i];
+				offsetSegment(segment.reversed(), distance, i == 0 ? LineJoin::Bevel : style.lineJoin, contour, 0);
+			}
+
+			if (!closed) {
+				addCap(contour);
+			}
+			pushStrokedContour(std::move(contour), source, closed);
+		}
+
+		output.recalculateBounds();
+	}
+
+	Outline OutlineStrokeToFill::intoOutline() {
+		return std::move(output);
+	}
+
+	void OutlineStrokeToFill::offsetSegment(const Segment& segment, float distance, LineJoin join, Contour& contour, int depth) const {
+		glm::vec2 joinPoint = segment.front();
+		glm::vec2 baseline = segment.back() - segment.front();
+		if (glm::dot(baseline, baseline) < tolerance * tolerance) {
+			addToContour(segment, distance, join, joinPoint, contour);
+			return;
+		}
+
+		Segment candidate = offsetOnce(segment, distance);
+		if (depth >= MaxOffsetDepth || errorIsWithinTolerance(segment, candidate, distance)) {
+			addToContour(candidate, distance, join, joinPoint, contour);
+			return;
+		}
+
+		std::array<Segment, 2> halves = segment.split(0.5f);
+		offsetSegment(halves[0], distance, join, contour, depth + 1);
+		offsetSegment(halves[1], distance, join, contour, depth + 1);
+	}
+
+	void OutlineStrokeToFill::addToContour(const Segment& segment, float distance, LineJoin join, const glm::vec2& joinPoint, Contour& contour) const {
+		if (mightNeedJoin(contour, join)) {
+			glm::vec2 p3 = segment.front();
+			glm::vec2 p4 = segment.isLine() ? segment.back() : segment.points[1];
+			addJoin(contour, distance, join, joinPoint, LineSegment2F{ p4, p3 });
+		}
+
+		contour.pushSegment(segment, true);
+	}
+
+	void OutlineStrokeToFill::addJoin(Contour& contour, float distance, LineJoin join, const glm::vec2& joinPoint, const LineSegment2F& nextTangent) const {
+		std::size_t count = contour.size();
+		LineSegment2F prevTangent{ contour[count - 2].point, contour[count - 1].point };
+
+		if (prevTangent.length2() < Eps || nextTangent.length2() < Eps) {
+			return;
+		}
+
+		// Only the outside of a corner needs filling. On the inside, and where the segments continue
+		// smoothly, the straight edge between the two offsets is already covered by the stroke.
+		glm::vec2 prevDir = glm::normalize(prevTangent.vector());
+		glm::vec2 nextDir = -glm::normalize(nextTangent.vector());
+		float turn = prevDir.x * nextDir.y - prevDir.y * nextDir.x;
+		if (turn * distance > 0.f || (std::abs(turn) < Eps && glm::dot(prevDir, nextDir) > 0.f)) {
+			return;
+		}
+
+		switch (join) {
+		case LineJoin::Bevel:
+			break;
+		case LineJoin::Miter: {
+			std::optional<float> t = prevTangent.intersect(nextTangent);
+			if (!t || *t < -Eps) {
+				return;
+			}
+
+			glm::vec2 miterEndpoint = prevTangent.sample(*t);
+			float threshold = style.miterLimit * distance;
+			glm::vec2 miter = miterEndpoint - joinPoint;
+			if (glm::dot(miter, miter) > threshold * threshold) {
+				return;
+			}
+			contour.pushEndpoint(miterEndpoint);
+			break;
+		}
+		case LineJoin::Round: {
+			Transform2F form = Transform2F::fromScale(std::abs(distance)).translate(joinPoint);
+			glm::vec2 chordFrom = glm::normalize(prevTangent.to() - joinPoint);
+			glm::vec2 chordTo = glm::normalize(nextTangent.to() - joinPoint);
+			contour.pushArcFromUnitChord(form, LineSegment2F{ chordFrom, chordTo }, ArcDirection::CW);
+			break;
+		}
+		}
+	}
+
+	void OutlineStrokeToFill::addCap(Contour& contour) const {
+		if (style.lineCap == LineCap::Butt || contour.size() < 2) {
+			return;
+		}
+
+		const float width = style.lineWidth;
+		glm::vec2 p1 = contour.back().point;
+
+		// Find the ending direction, skipping over coincident points.
+		glm::vec2 p0;
+		std::size_t index = contour.size() - 2;
+		for (;;) {
+			p0 = contour[index].point;
+			glm::vec2 dir = p1 - p0;
+			if (glm::dot(dir, dir) > Eps) {
+				break;
+			}
+			if (index == 0) {
+				return;
+			}
+			--index;
+		}
+		glm::vec2 gradient = glm::normalize(p1 - p0);
+
+		if (style.lineCap == LineCap::Square) {
+			glm::vec2 offset = gradient * (width * 0.5f);
+
+			glm::vec2 p2 = p1 + offset;
+			glm::vec2 p3 = p2 + glm::vec2{ -gradient.y, gradient.x } * width;
+			glm::vec2 p4 = p3 - offset;
+
+			contour.pushEndpoint(p2);
+			contour.pushEndpoint(p3);
+			contour.pushEndpoint(p4);
+		}
+		else {
+			glm::vec2 offset{ -gradient.y, gradient.x };
+			Transform2F form = Transform2F::fromScale(width * 0.5f).translate(p1 + offset * (width * 0.5f));
+			contour.pushArcFromUnitChord(form, LineSegment2F{ -offset, offset }, ArcDirection::CW);
+		}
+	}
+
+	void OutlineStrokeToFill::pushStrokedContour(Contour&& contour, const Contour& source, bool closed) {
+		if (closed && mightNeedJoin(contour, style.lineJoin)) {
+			LineSegment2F finalSegment{ contour[1].point, contour[0].point };
+			addJoin(contour, -style.lineWidth * 0.5f, style.lineJoin, source.front().point, finalSegment);
+		}
+
+		if (contour.empty()) {
+			return;
+		}
+		contour.closed = true;
+		output.contours.push_back(std::move(contour));
+	}
+
+	// Measures the gap along the normal of the source curve, so the offset curve is not penalized for
+	// being parameterized differently. Points that drift along the curve by more than the stroke
+	// radius are rejected anyway, since the normal no longer says much about them.
+	bool OutlineStrokeToFill::errorIsWithinTolerance(const Segment& segment, const Segment& offset, float distance) const noexcept {
+		const float radius = std::abs(distance);
+
+		for (int i = 0; i <= OffsetSampleCount; ++i) {
+			float t = static_cast<float>(i) / static_cast<float>(OffsetSampleCount);
+			glm::vec2 tangent = derivative(segment, t);
+			float len2 = glm::dot(tangent, tangent);
+			if (len2 < Eps * Eps) {
+				continue;
+			}
+			tangent /= std::sqrt(len2);
+
+			glm::vec2 delta = offset.sample(t) - segment.sample(t);
+			float along = glm::dot(delta, tangent);
+			float across = delta.x * tangent.y - delta.y * tangent.x;
+			if (std::abs(std::abs(across) - radius) > tolerance || std::abs(along) > radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Outline strokeToFill(const Outline& outline, const StrokeStyle& style, float tolerance) {
+		OutlineStrokeToFill stroker{ outline, style, tolerance };
+		stroker.offset();
+		return stroker.intoOutline();
+	}
+};
\ No newline at end of file
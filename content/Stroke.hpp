@@ -1,5 +1,74 @@
 #pragma once
+#include <vector>
+
+#include "../geometry/LineSegment.hpp"
+
+#include "Outline.hpp"
+#include "Segment.hpp"
 
 namespace pf {
+	// How far an offset curve may stray from the true offset before it gets split.
+	static constexpr float StrokeTolerance = 0.01f;
+
+	// The shape of the ends of the stroke.
+	enum class LineCap {
+		/// The ends of lines are squared off at the endpoints.
+		Butt,
+		/// The ends of lines are squared off by adding a box with an equal width and half the height
+		/// of the line's thickness.
+		Square,
+		/// The ends of lines are rounded.
+		Round,
+	};
+
+	// The shape used to join two line segments where they meet.
+	enum class LineJoin {
+		/// The outside edges are extended to meet at a single point, unless that point is further
+		/// than miterLimit times half the line width from the join.
+		Miter,
+		/// Fills the triangle between the outside corners of the two segments.
+		Bevel,
+		/// Fills a sector of a disc centered on the join, with a radius of half the line width.
+		Round,
+	};
+
+	struct StrokeStyle {
+		StrokeStyle() noexcept;
+		StrokeStyle(float _lineWidth, LineCap _lineCap, LineJoin _lineJoin, float _miterLimit = 10.f) noexcept;
+
+		float lineWidth;
+		LineCap lineCap;
+		LineJoin lineJoin;
+		float miterLimit;
+	};
+
+	// Converts the stroke of an outline into an outline that can be filled.
+	// The segments of each input contour are gathered once into a scratch buffer that is reused
+	// for both sides of the stroke, and for every contour after it.
+	struct OutlineStrokeToFill {
+		OutlineStrokeToFill(const Outline& _input, const StrokeStyle& _style, float _tolerance = StrokeTolerance);
+
+		// Performs the stroke operation, replacing the contents of output.
+		void offset();
+
+		// Returns the stroked outline, call after offset.
+		Outline intoOutline();
+
+		const Outline* input;
+		Outline output;
+		StrokeStyle style;
+		float tolerance;
+	private:
+		void offsetSegment(const Segment& segment, float distance, LineJoin join, Contour& contour, int depth) const;
+		void addToContour(const Segment& segment, float distance, LineJoin join, const glm::vec2& joinPoint, Contour& contour) const;
+		void addJoin(Contour& contour, float distance, LineJoin join, const glm::vec2& joinPoint, const LineSegment2F& nextTangent) const;
+		void addCap(Contour& contour) const;
+		void pushStrokedContour(Contour&& contour, const Contour& source, bool closed);
+		bool errorIsWithinTolerance(const Segment& segment, const Segment& offset, float distance) const noexcept;
+
+		std::vector<Segment> segments;
+	};
 
+	// Shorthand for OutlineStrokeToFill, for when the stroker does not need to be reused.
+	Outline strokeToFill(const Outline& outline, const StrokeStyle& style, float tolerance = StrokeTolerance);
 };
\ No newline at end of file
@@ -19,16 +19,16 @@ namespace pf {
 		return glm::vec2(z, w);
 	}
 	float LineSegment2F::toX() const noexcept {
-		return x;
+		return z;
 	}
 	float LineSegment2F::toY() const noexcept {
-		return y;
+		return w;
 	}
 	float LineSegment2F::fromX() const noexcept {
-		return z;
+		return x;
 	}
 	float LineSegment2F::fromY() const noexcept {
-		return w;
+		return y;
 	}
 
 	void LineSegment2F::setFrom(const glm::vec2& val) noexcept {
@@ -36,8 +36,8 @@ namespace pf {
 		y = val.y;
 	}
 	void LineSegment2F::setTo(const glm::vec2& val) noexcept {
-		w = val.x;
-		z = val.y;
+		z = val.x;
+		w = val.y;
 	}
 	std::array<LineSegment2F, 2> LineSegment2F::split(float t) const noexcept {
 		glm::vec2 tmp = sample(t);
@@ -169,4 +169,21 @@ namespace pf {
 		}
 		return { (glm::inverse(matrix) * (from() - other.from())).y };
 	}
+}
+
+pf::LineSegment2F operator+(const pf::LineSegment2F& lh, const glm::vec2& rh) noexcept {
+	return pf::LineSegment2F{ lh.from() + rh, lh.to() + rh };
+}
+pf::LineSegment2F operator-(const pf::LineSegment2F& lh, const glm::vec2& rh) noexcept {
+	return pf::LineSegment2F{ lh.from() - rh, lh.to() - rh };
+}
+pf::LineSegment2F operator*(const pf::LineSegment2F& lh, const glm::vec2& rh) noexcept {
+	return pf::LineSegment2F{ lh.from() * rh, lh.to() * rh };
+}
+pf::LineSegment2F operator*(const pf::LineSegment2F& lh, float rh) noexcept {
+	return pf::LineSegment2F{ lh.from() * rh, lh.to() * rh };
+}
+pf::LineSegment2F& operator*=(pf::LineSegment2F& lh, const glm::vec2& rh) noexcept {
+	lh = lh * rh;
+	return lh;
 }
\ No newline at end of file
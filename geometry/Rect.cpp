@@ -167,6 +167,9 @@ namespace pf {
 		return RectI(upperLeft, upperLeft + size);
 	}
 
+	RectI::RectI() noexcept
+		: data{ 0 }
+	{}
 	RectI::RectI(const glm::ivec2& upperLeft, const glm::ivec2& lowerRight) noexcept
 		: data{upperLeft, lowerRight}
 	{}
@@ -81,6 +81,7 @@ namespace pf {
 		static RectI fromPoints(const glm::ivec2& _origin, const glm::ivec2& _lowerRight) noexcept;
 		static RectI fromOriginSize(const glm::ivec2& _origin, const glm::ivec2& size) noexcept;
 
+		RectI() noexcept;
 		RectI(const glm::ivec2& _origin, const glm::ivec2& _lowerRight) noexcept;
 		RectI(const RectF& other) noexcept;
 		RectI(const glm::ivec4& other) noexcept;
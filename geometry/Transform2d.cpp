@@ -1,6 +1,7 @@
 #include "Transform2d.hpp"
 #include "LineSegment.hpp"
 #include "Rect.hpp"
+#include "../simd/Simd.hpp"
 #include <cmath>
 
 namespace pf {
@@ -71,6 +72,363 @@ namespace pf {
 		return Transform2F{ matrix * val.matrix, apply(val.vector) };
 	}
 
+	// All the kernels evaluate (m0 * x + m1 * y) + t with separate multiplies and adds, in the same order as apply,
+	// so every dispatch level produces bit identical results, as long as the compiler doesn't contract the scalar
+	// code into fused multiply-adds; CMakeLists.txt turns that off. When Bounds is set they also fold the transformed
+	// points into lo and hi, and return how many points they handled, leaving the tail to the scalar loop.
+
+	static const glm::vec2& pointAt(const glm::vec2* points, std::size_t i, std::size_t stride) noexcept {
+		return *reinterpret_cast<const glm::vec2*>(reinterpret_cast<const char*>(points) + i * stride);
+	}
+	static glm::vec2& pointAt(glm::vec2* points, std::size_t i, std::size_t stride) noexcept {
+		return *reinterpret_cast<glm::vec2*>(reinterpret_cast<char*>(points) + i * stride);
+	}
+
+#if defined(PF_SIMD_SSE2)
+	static float reduceMin(__m128 v) noexcept {
+		v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+		v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(v);
+	}
+	static float reduceMax(__m128 v) noexcept {
+		v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+		v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtss_f32(v);
+	}
+
+	template<bool Bounds>
+	static std::size_t applyBatchSSE2(const Transform2F& form, const float* xs, const float* ys, float* outX, float* outY, std::size_t n, glm::vec2& lo, glm::vec2& hi) noexcept {
+		const __m128 m00 = _mm_set1_ps(form.matrix[0][0]), m01 = _mm_set1_ps(form.matrix[0][1]);
+		const __m128 m10 = _mm_set1_ps(form.matrix[1][0]), m11 = _mm_set1_ps(form.matrix[1][1]);
+		const __m128 tx = _mm_set1_ps(form.vector.x), ty = _mm_set1_ps(form.vector.y);
+		__m128 minX = _mm_set1_ps(lo.x), minY = _mm_set1_ps(lo.y), maxX = _mm_set1_ps(hi.x), maxY = _mm_set1_ps(hi.y);
+
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m128 x = _mm_loadu_ps(xs + i), y = _mm_loadu_ps(ys + i);
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), tx);
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), ty);
+			_mm_storeu_ps(outX + i, rx);
+			_mm_storeu_ps(outY + i, ry);
+
+			if constexpr (Bounds) {
+				minX = _mm_min_ps(minX, rx);
+				minY = _mm_min_ps(minY, ry);
+				maxX = _mm_max_ps(maxX, rx);
+				maxY = _mm_max_ps(maxY, ry);
+			}
+		}
+
+		if constexpr (Bounds) {
+			lo = glm::vec2{ reduceMin(minX), reduceMin(minY) };
+			hi = glm::vec2{ reduceMax(maxX), reduceMax(maxY) };
+		}
+		return i;
+	}
+	template<bool Bounds>
+	static std::size_t applyBatchSSE2(const Transform2F& form, const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride, glm::vec2& lo, glm::vec2& hi) noexcept {
+		// Two points per register, laid out as x0 y0 x1 y1.
+		const __m128 col0 = _mm_setr_ps(form.matrix[0][0], form.matrix[0][1], form.matrix[0][0], form.matrix[0][1]);
+		const __m128 col1 = _mm_setr_ps(form.matrix[1][0], form.matrix[1][1], form.matrix[1][0], form.matrix[1][1]);
+		const __m128 vec = _mm_setr_ps(form.vector.x, form.vector.y, form.vector.x, form.vector.y);
+		__m128 minXY = _mm_setr_ps(lo.x, lo.y, lo.x, lo.y), maxXY = _mm_setr_ps(hi.x, hi.y, hi.x, hi.y);
+
+		std::size_t i = 0;
+		for (; i + 2 <= n; i += 2) {
+			__m128 p = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&pointAt(points, i, stride)));
+			p = _mm_loadh_pi(p, reinterpret_cast<const __m64*>(&pointAt(points, i + 1, stride)));
+
+			__m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+			__m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+			__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, x), _mm_mul_ps(col1, y)), vec);
+
+			_mm_storel_pi(reinterpret_cast<__m64*>(&pointAt(out, i, stride)), r);
+			_mm_storeh_pi(reinterpret_cast<__m64*>(&pointAt(out, i + 1, stride)), r);
+
+			if constexpr (Bounds) {
+				minXY = _mm_min_ps(minXY, r);
+				maxXY = _mm_max_ps(maxXY, r);
+			}
+		}
+
+		if constexpr (Bounds) {
+			minXY = _mm_min_ps(minXY, _mm_movehl_ps(minXY, minXY));
+			maxXY = _mm_max_ps(maxXY, _mm_movehl_ps(maxXY, maxXY));
+			_mm_storel_pi(reinterpret_cast<__m64*>(&lo.x), minXY);
+			_mm_storel_pi(reinterpret_cast<__m64*>(&hi.x), maxXY);
+		}
+		return i;
+	}
+
+	template<bool Bounds>
+	PF_TARGET_AVX2 static std::size_t applyBatchAVX2(const Transform2F& form, const float* xs, const float* ys, float* outX, float* outY, std::size_t n, glm::vec2& lo, glm::vec2& hi) noexcept {
+		const __m256 m00 = _mm256_set1_ps(form.matrix[0][0]), m01 = _mm256_set1_ps(form.matrix[0][1]);
+		const __m256 m10 = _mm256_set1_ps(form.matrix[1][0]), m11 = _mm256_set1_ps(form.matrix[1][1]);
+		const __m256 tx = _mm256_set1_ps(form.vector.x), ty = _mm256_set1_ps(form.vector.y);
+		__m256 minX = _mm256_set1_ps(lo.x), minY = _mm256_set1_ps(lo.y), maxX = _mm256_set1_ps(hi.x), maxY = _mm256_set1_ps(hi.y);
+
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8) {
+			__m256 x = _mm256_loadu_ps(xs + i), y = _mm256_loadu_ps(ys + i);
+			__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m10, y)), tx);
+			__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m01, x), _mm256_mul_ps(m11, y)), ty);
+			_mm256_storeu_ps(outX + i, rx);
+			_mm256_storeu_ps(outY + i, ry);
+
+			if constexpr (Bounds) {
+				minX = _mm256_min_ps(minX, rx);
+				minY = _mm256_min_ps(minY, ry);
+				maxX = _mm256_max_ps(maxX, rx);
+				maxY = _mm256_max_ps(maxY, ry);
+			}
+		}
+
+		if constexpr (Bounds) {
+			lo = glm::vec2{
+				reduceMin(_mm_min_ps(_mm256_castps256_ps128(minX), _mm256_extractf128_ps(minX, 1))),
+				reduceMin(_mm_min_ps(_mm256_castps256_ps128(minY), _mm256_extractf128_ps(minY, 1))) };
+			hi = glm::vec2{
+				reduceMax(_mm_max_ps(_mm256_castps256_ps128(maxX), _mm256_extractf128_ps(maxX, 1))),
+				reduceMax(_mm_max_ps(_mm256_castps256_ps128(maxY), _mm256_extractf128_ps(maxY, 1))) };
+		}
+		return i;
+	}
+	// Contiguous points only, the strided case gains nothing over SSE2.
+	template<bool Bounds>
+	PF_TARGET_AVX2 static std::size_t applyBatchAVX2(const Transform2F& form, const glm::vec2* points, glm::vec2* out, std::size_t n, glm::vec2& lo, glm::vec2& hi) noexcept {
+		const float m00 = form.matrix[0][0], m01 = form.matrix[0][1], m10 = form.matrix[1][0], m11 = form.matrix[1][1];
+		const __m256 col0 = _mm256_setr_ps(m00, m01, m00, m01, m00, m01, m00, m01);
+		const __m256 col1 = _mm256_setr_ps(m10, m11, m10, m11, m10, m11, m10, m11);
+		const __m256 vec = _mm256_setr_ps(
+			form.vector.x, form.vector.y, form.vector.x, form.vector.y, 
+			form.vector.x, form.vector.y, form.vector.x, form.vector.y);
+		__m256 minXY = _mm256_setr_ps(lo.x, lo.y, lo.x, lo.y, lo.x, lo.y, lo.x, lo.y);
+		__m256 maxXY = _mm256_setr_ps(hi.x, hi.y, hi.x, hi.y, hi.x, hi.y, hi.x, hi.y);
+
+		const float* src = &points[0].x;
+		float* dst = &out[0].x;
+
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			__m256 p = _mm256_loadu_ps(src + i * 2);
+			__m256 x = _mm256_moveldup_ps(p);
+			__m256 y = _mm256_movehdup_ps(p);
+			__m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(col0, x), _mm256_mul_ps(col1, y)), vec);
+			_mm256_storeu_ps(dst + i * 2, r);
+
+			if constexpr (Bounds) {
+				minXY = _mm256_min_ps(minXY, r);
+				maxXY = _mm256_max_ps(maxXY, r);
+			}
+		}
+
+		if constexpr (Bounds) {
+			__m128 minHalf = _mm_min_ps(_mm256_castps256_ps128(minXY), _mm256_extractf128_ps(minXY, 1));
+			__m128 maxHalf = _mm_max_ps(_mm256_castps256_ps128(maxXY), _mm256_extractf128_ps(maxXY, 1));
+			minHalf = _mm_min_ps(minHalf, _mm_movehl_ps(minHalf, minHalf));
+			maxHalf = _mm_max_ps(maxHalf, _mm_movehl_ps(maxHalf, maxHalf));
+			_mm_storel_pi(reinterpret_cast<__m64*>(&lo.x), minHalf);
+			_mm_storel_pi(reinterpret_cast<__m64*>(&hi.x), maxHalf);
+		}
+		return i;
+	}
+#elif defined(PF_SIMD_NEON)
+	static float reduceMin(float32x4_t v) noexcept {
+		float32x2_t h = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+		return vget_lane_f32(vpmin_f32(h, h), 0);
+	}
+	static float reduceMax(float32x4_t v) noexcept {
+		float32x2_t h = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+		return vget_lane_f32(vpmax_f32(h, h), 0);
+	}
+
+	template<bool Bounds>
+	static std::size_t applyBatchNEON(const Transform2F& form, const float* xs, const float* ys, float* outX, float* outY, std::size_t n, glm::vec2& lo, glm::vec2& hi) noexcept {
+		const float32x4_t m00 = vdupq_n_f32(form.matrix[0][0]), m01 = vdupq_n_f32(form.matrix[0][1]);
+		const float32x4_t m10 = vdupq_n_f32(form.matrix[1][0]), m11 = vdupq_n_f32(form.matrix[1][1]);
+		const float32x4_t tx = vdupq_n_f32(form.vector.x), ty = vdupq_n_f32(form.vector.y);
+		float32x4_t minX = vdupq_n_f32(lo.x), minY = vdupq_n_f32(lo.y), maxX = vdupq_n_f32(hi.x), maxY = vdupq_n_f32(hi.y);
+
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			float32x4_t x = vld1q_f32(xs + i), y = vld1q_f32(ys + i);
+			float32x4_t rx = vaddq_f32(vaddq_f32(vmulq_f32(m00, x), vmulq_f32(m10, y)), tx);
+			float32x4_t ry = vaddq_f32(vaddq_f32(vmulq_f32(m01, x), vmulq_f32(m11, y)), ty);
+			vst1q_f32(outX + i, rx);
+			vst1q_f32(outY + i, ry);
+
+			if constexpr (Bounds) {
+				minX = vminq_f32(minX, rx);
+				minY = vminq_f32(minY, ry);
+				maxX = vmaxq_f32(maxX, rx);
+				maxY = vmaxq_f32(maxY, ry);
+			}
+		}
+
+		if constexpr (Bounds) {
+			lo = glm::vec2{ reduceMin(minX), reduceMin(minY) };
+			hi = glm::vec2{ reduceMax(maxX), reduceMax(maxY) };
+		}
+		return i;
+	}
+	template<bool Bounds>
+	static std::size_t applyBatchNEON(const Transform2F& form, const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride, glm::vec2& lo, glm::vec2& hi) noexcept {
+		std::size_t i = 0;
+		if (stride == sizeof(glm::vec2)) {
+			// vld2 splits four interleaved points into an x and a y register.
+			const float32x4_t m00 = vdupq_n_f32(form.matrix[0][0]), m01 = vdupq_n_f32(form.matrix[0][1]);
+			const float32x4_t m10 = vdupq_n_f32(form.matrix[1][0]), m11 = vdupq_n_f32(form.matrix[1][1]);
+			const float32x4_t tx = vdupq_n_f32(form.vector.x), ty = vdupq_n_f32(form.vector.y);
+			float32x4_t minX = vdupq_n_f32(lo.x), minY = vdupq_n_f32(lo.y), maxX = vdupq_n_f32(hi.x), maxY = vdupq_n_f32(hi.y);
+
+			const float* src = &points[0].x;
+			float* dst = &out[0].x;
+			for (; i + 4 <= n; i += 4) {
+				float32x4x2_t p = vld2q_f32(src + i * 2);
+				float32x4x2_t r;
+				r.val[0] = vaddq_f32(vaddq_f32(vmulq_f32(m00, p.val[0]), vmulq_f32(m10, p.val[1])), tx);
+				r.val[1] = vaddq_f32(vaddq_f32(vmulq_f32(m01, p.val[0]), vmulq_f32(m11, p.val[1])), ty);
+				vst2q_f32(dst + i * 2, r);
+
+				if constexpr (Bounds) {
+					minX = vminq_f32(minX, r.val[0]);
+					minY = vminq_f32(minY, r.val[1]);
+					maxX = vmaxq_f32(maxX, r.val[0]);
+					maxY = vmaxq_f32(maxY, r.val[1]);
+				}
+			}
+
+			if constexpr (Bounds) {
+				lo = glm::vec2{ reduceMin(minX), reduceMin(minY) };
+				hi = glm::vec2{ reduceMax(maxX), reduceMax(maxY) };
+			}
+			return i;
+		}
+
+		const float m00 = form.matrix[0][0], m01 = form.matrix[0][1], m10 = form.matrix[1][0], m11 = form.matrix[1][1];
+		const float col0Data[4] = { m00, m01, m00, m01 }, col1Data[4] = { m10, m11, m10, m11 };
+		const float vecData[4] = { form.vector.x, form.vector.y, form.vector.x, form.vector.y };
+		const float32x4_t col0 = vld1q_f32(col0Data), col1 = vld1q_f32(col1Data), vec = vld1q_f32(vecData);
+		float32x2_t minXY = vld1_f32(&lo.x), maxXY = vld1_f32(&hi.x);
+
+		for (; i + 2 <= n; i += 2) {
+			float32x4_t p = vcombine_f32(vld1_f32(&pointAt(points, i, stride).x), vld1_f32(&pointAt(points, i + 1, stride).x));
+			float32x4x2_t xy = vtrnq_f32(p, p);
+			float32x4_t r = vaddq_f32(vaddq_f32(vmulq_f32(col0, xy.val[0]), vmulq_f32(col1, xy.val[1])), vec);
+			vst1_f32(&pointAt(out, i, stride).x, vget_low_f32(r));
+			vst1_f32(&pointAt(out, i + 1, stride).x, vget_high_f32(r));
+
+			if constexpr (Bounds) {
+				minXY = vmin_f32(minXY, vmin_f32(vget_low_f32(r), vget_high_f32(r)));
+				maxXY = vmax_f32(maxXY, vmax_f32(vget_low_f32(r), vget_high_f32(r)));
+			}
+		}
+
+		if constexpr (Bounds) {
+			vst1_f32(&lo.x, minXY);
+			vst1_f32(&hi.x, maxXY);
+		}
+		return i;
+	}
+#endif
+
+	template<bool Bounds>
+	static void applyBatchImpl(const Transform2F& form, const float* xs, const float* ys, float* outX, float* outY, std::size_t n, glm::vec2& lo, glm::vec2& hi) noexcept {
+		std::size_t i = 0;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+			i = applyBatchAVX2<Bounds>(form, xs, ys, outX, outY, n, lo, hi);
+			break;
+		case SimdLevel::SSE2:
+			i = applyBatchSSE2<Bounds>(form, xs, ys, outX, outY, n, lo, hi);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = applyBatchNEON<Bounds>(form, xs, ys, outX, outY, n, lo, hi);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i < n; ++i) {
+			float x = xs[i], y = ys[i];
+			outX[i] = form.matrix[0][0] * x + form.matrix[1][0] * y + form.vector.x;
+			outY[i] = form.matrix[0][1] * x + form.matrix[1][1] * y + form.vector.y;
+
+			if constexpr (Bounds) {
+				lo = glm::min(lo, glm::vec2{ outX[i], outY[i] });
+				hi = glm::max(hi, glm::vec2{ outX[i], outY[i] });
+			}
+		}
+	}
+	template<bool Bounds>
+	static void applyBatchImpl(const Transform2F& form, const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride, glm::vec2& lo, glm::vec2& hi) noexcept {
+		std::size_t i = 0;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+			if (stride == sizeof(glm::vec2)) {
+				i = applyBatchAVX2<Bounds>(form, points, out, n, lo, hi);
+				break;
+			}
+			i = applyBatchSSE2<Bounds>(form, points, out, n, stride, lo, hi);
+			break;
+		case SimdLevel::SSE2:
+			i = applyBatchSSE2<Bounds>(form, points, out, n, stride, lo, hi);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = applyBatchNEON<Bounds>(form, points, out, n, stride, lo, hi);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i < n; ++i) {
+			glm::vec2 result = form.apply(pointAt(points, i, stride));
+			pointAt(out, i, stride) = result;
+
+			if constexpr (Bounds) {
+				lo = glm::min(lo, result);
+				hi = glm::max(hi, result);
+			}
+		}
+	}
+
+	void Transform2F::applyBatch(const float* xs, const float* ys, float* outX, float* outY, std::size_t n) const noexcept {
+		glm::vec2 lo{ 0.f }, hi{ 0.f };
+		applyBatchImpl<false>(*this, xs, ys, outX, outY, n, lo, hi);
+	}
+	void Transform2F::applyBatch(const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride) const noexcept {
+		glm::vec2 lo{ 0.f }, hi{ 0.f };
+		applyBatchImpl<false>(*this, points, out, n, stride, lo, hi);
+	}
+
+	RectF Transform2F::applyBatchBounds(const float* xs, const float* ys, float* outX, float* outY, std::size_t n) const noexcept {
+		if (n == 0) {
+			return RectF{};
+		}
+
+		// Seeding with the first transformed point keeps the accumulators free of sentinel values.
+		glm::vec2 first = apply(glm::vec2{ xs[0], ys[0] });
+		glm::vec2 lo = first, hi = first;
+		applyBatchImpl<true>(*this, xs, ys, outX, outY, n, lo, hi);
+		return RectF::fromPoints(lo, hi);
+	}
+	RectF Transform2F::applyBatchBounds(const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride) const noexcept {
+		if (n == 0) {
+			return RectF{};
+		}
+
+		glm::vec2 first = apply(points[0]);
+		glm::vec2 lo = first, hi = first;
+		applyBatchImpl<true>(*this, points, out, n, stride, lo, hi);
+		return RectF::fromPoints(lo, hi);
+	}
+
 	Transform2F Transform2F::rowMajor(const glm::vec3& row0, const glm::vec3& row1) noexcept {
 		glm::mat2 mat{ row0.x, row1.x, row0.y, row1.y };
 		glm::vec2 vec{ row0.z, row1.z };
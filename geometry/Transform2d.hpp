@@ -1,6 +1,7 @@
 #pragma once
 #include <glm/vec2.hpp>
 #include <glm/mat2x2.hpp>
+#include <cstddef>
 
 namespace pf {
 	struct LineSegment2F;
@@ -32,6 +33,15 @@ namespace pf {
 		RectF apply(const RectF& val) const noexcept;
 		Transform2F apply(const Transform2F& val) const noexcept;
 
+		// Transforms n points at once, using the widest SIMD kernel the CPU supports.
+		// The outputs may alias the inputs exactly, but must not partially overlap them.
+		void applyBatch(const float* xs, const float* ys, float* outX, float* outY, std::size_t n) const noexcept;
+		// Stride is the distance in bytes between consecutive points, so points embedded in larger structs can be transformed in place.
+		void applyBatch(const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride = sizeof(glm::vec2)) const noexcept;
+		// Same as applyBatch, but also returns the bounds of the transformed points, computed in the same pass.
+		RectF applyBatchBounds(const float* xs, const float* ys, float* outX, float* outY, std::size_t n) const noexcept;
+		RectF applyBatchBounds(const glm::vec2* points, glm::vec2* out, std::size_t n, std::size_t stride = sizeof(glm::vec2)) const noexcept;
+
 		static Transform2F rowMajor(const glm::vec3 & row0, const glm::vec3 & row1) noexcept;
 		static Transform2F columnMajor(const glm::vec2& col0, const glm::vec2& col1, const glm::vec2& col2) noexcept;
 
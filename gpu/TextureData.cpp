@@ -1,4 +1,4 @@
-#include "GPU.hpp"
+#include "TextureData.hpp"
 #include <new>
 #include <cassert>
 
@@ -1,6 +1,8 @@
 #pragma once
 #include <cinttypes>
+#include <vector>
 #include <glm/vec2.hpp>
+#include "Enums.hpp"
 #include "half.hpp"
 
 namespace pf {
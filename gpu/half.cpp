@@ -10,44 +10,95 @@ namespace pf {
 		uint64_t ival;
 	};
 
-	static float makeFloat(half val) {
+	// Every half is exactly representable as a float, including subnormals, infinities and NaNs.
+	float makeFloat(half val) {
 		ConvertFloat convert;
-		uint32_t exponent = ((val.data & 0x7C00) + 0x1C000);
+		uint32_t sign = static_cast<uint32_t>(val.data & 0x8000) << 16;
+		uint32_t exponent = (val.data >> 10) & 0x1F;
+		uint32_t mantissa = val.data & 0x3FF;
 
-		convert.ival =
-			((val.data & 0x8000) << 16) |
-			(exponent << 13) |
-			((val.data & 0x3FF) << 13);
+		if (exponent == 0x1F) {
+			convert.ival = sign | 0x7F80'0000 | (mantissa << 13);
+		}
+		else if (exponent != 0) {
+			convert.ival = sign | ((exponent + 112) << 23) | (mantissa << 13);
+		}
+		else if (mantissa == 0) {
+			convert.ival = sign;
+		}
+		else {
+			// Subnormal, normalize it.
+			uint32_t shift = 0;
+			while ((mantissa & 0x400) == 0) {
+				mantissa <<= 1;
+				++shift;
+			}
+			convert.ival = sign | ((113 - shift) << 23) | ((mantissa & 0x3FF) << 13);
+		}
 
 		return convert.val;
 	}
-	static double makeDouble(half val) {
-		ConvertDouble convert;
-		uint64_t exponent = (val.data & 0x7C00ull) + 0xFC000ull;
+	double makeDouble(half val) {
+		return static_cast<double>(makeFloat(val));
+	}
 
-		convert.ival =
-			(static_cast<uint64_t>(val.data & 0x8000) << 48) |
-			(exponent << 42) |
-			(static_cast<uint64_t>(val.data & 0x03FF) << 42);
-		return convert.val;
+	// Rounds a magnitude to the nearest half, ties to even. The magnitude is significand * 2^(exponent - bits),
+	// with the leading one of significand at bit bits.
+	static uint16_t roundToHalf(uint16_t sign, int exponent, uint64_t significand, int bits) {
+		int biased = exponent + 15;
+		if (biased >= 0x1F) {
+			return sign | 0x7C00;
+		}
+
+		// Subnormals keep fewer bits, with the exponent pinned at its minimum.
+		int shift = bits - 10 + (biased <= 0 ? 1 - biased : 0);
+		if (shift > bits + 1) {
+			return sign;
+		}
+
+		uint64_t kept = significand >> shift;
+		uint64_t rest = significand & ((uint64_t(1) << shift) - 1);
+		uint64_t halfway = uint64_t(1) << (shift - 1);
+		if (rest > halfway || (rest == halfway && (kept & 1))) {
+			++kept;
+		}
+
+		// For normals the leading one lands in the exponent field, which is why the exponent is one less.
+		// Rounding up can carry into the next exponent, or into infinity, and stays correct.
+		uint32_t exponentField = biased > 0 ? static_cast<uint32_t>(biased - 1) << 10 : 0;
+		return static_cast<uint16_t>(sign | (exponentField + kept));
 	}
-	static uint16_t makeHalf(float val) {
+
+	uint16_t makeHalf(float val) {
 		ConvertFloat convert;
 		convert.val = val;
-		uint16_t res =
-			((convert.ival & 0xC000'0000) >> 16) |
-			((convert.ival & 0x0780'0000) >> 13) |
-			((convert.ival & 0x007F'C000) >> 13);
-		return res;
+		uint16_t sign = static_cast<uint16_t>((convert.ival >> 16) & 0x8000);
+		uint32_t exponent = (convert.ival >> 23) & 0xFF;
+		uint32_t mantissa = convert.ival & 0x7F'FFFF;
+
+		if (exponent == 0xFF) {
+			return sign | 0x7C00 | (mantissa != 0 ? 0x200 | (mantissa >> 13) : 0);
+		}
+		if (exponent == 0) {
+			// Float subnormals are far below the smallest half.
+			return sign;
+		}
+		return roundToHalf(sign, static_cast<int>(exponent) - 127, mantissa | 0x80'0000, 23);
 	}
-	static uint16_t makeHalf(double val) {
+	uint16_t makeHalf(double val) {
 		ConvertDouble convert;
 		convert.val = val;
-		uint16_t res =
-			((convert.ival & 0xC000'0000'0000'0000ull) >> 48) |
-			((convert.ival & 0x0780'0000'0000'0000ull) >> 42) |
-			((convert.ival >> 42) & 0x03FFull);
-		return res;
+		uint16_t sign = static_cast<uint16_t>((convert.ival >> 48) & 0x8000);
+		uint64_t exponent = (convert.ival >> 52) & 0x7FF;
+		uint64_t mantissa = convert.ival & 0xF'FFFF'FFFF'FFFFull;
+
+		if (exponent == 0x7FF) {
+			return sign | 0x7C00 | (mantissa != 0 ? 0x200 | static_cast<uint16_t>(mantissa >> 42) : 0);
+		}
+		if (exponent == 0) {
+			return sign;
+		}
+		return roundToHalf(sign, static_cast<int>(exponent) - 1023, mantissa | 0x10'0000'0000'0000ull, 52);
 	}
 
 	half::half(float val) noexcept
@@ -8,8 +8,8 @@ namespace pf {
 		~half() = default;
 
 		half(float val = 0.f) noexcept;
-		half(double val = 0.0) noexcept;
-		half(long double val = static_cast<long double>(0)) noexcept;
+		half(double val) noexcept;
+		half(long double val) noexcept;
 
 		operator float() const noexcept;
 		operator double() const noexcept;
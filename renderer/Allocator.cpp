@@ -0,0 +1,282 @@
+#include "Allocator.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace pf {
+	// Deep enough for any 32 bit length.
+	static constexpr int MaxTreeDepth = 33;
+
+	static uint32_t nextPowerOfTwo(uint32_t value) noexcept {
+		uint32_t result = 1;
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+	TextureAtlasAllocator::TextureAtlasAllocator(uint32_t _length)
+		: rootLength(nextPowerOfTwo(std::max(_length, 1u)))
+		, used(0)
+	{
+		nodes.push_back(Node{ NodeKind::EmptyLeaf, 0, rootLength });
+	}
+
+	bool TextureAtlasAllocator::empty() const noexcept {
+		return nodes[0].kind == NodeKind::EmptyLeaf;
+	}
+	uint32_t TextureAtlasAllocator::length() const noexcept {
+		return rootLength;
+	}
+	uint64_t TextureAtlasAllocator::usedArea() const noexcept {
+		return used;
+	}
+	uint32_t TextureAtlasAllocator::largestFreeLength() const noexcept {
+		return nodes[0].largestFree;
+	}
+	float TextureAtlasAllocator::fragmentation() const noexcept {
+		uint64_t freeArea = static_cast<uint64_t>(rootLength) * rootLength - used;
+		if (freeArea == 0) {
+			return 0.f;
+		}
+		uint64_t largest = static_cast<uint64_t>(largestFreeLength()) * largestFreeLength();
+		return 1.f - static_cast<float>(largest) / static_cast<float>(freeArea);
+	}
+
+	uint32_t TextureAtlasAllocator::allocateGroup(uint32_t childLength) {
+		uint32_t first;
+		if (freeGroups.empty()) {
+			first = static_cast<uint32_t>(nodes.size());
+			nodes.resize(nodes.size() + 4);
+		}
+		else {
+			first = freeGroups.back();
+			freeGroups.pop_back();
+		}
+
+		for (uint32_t i = 0; i < 4; ++i) {
+			nodes[first + i] = Node{ NodeKind::EmptyLeaf, 0, childLength };
+		}
+		return first;
+	}
+
+	// Recomputes the largest free square of every parent on the path, from the bottom up, merging
+	// parents whose four children are all empty.
+	void TextureAtlasAllocator::updateAncestors(const uint32_t* path, int depth, uint32_t length) {
+		for (int i = depth - 1; i >= 0; --i) {
+			length <<= 1;
+			Node& node = nodes[path[i]];
+			const Node* kids = nodes.data() + node.children;
+
+			bool allEmpty = true;
+			uint32_t largest = 0;
+			for (int k = 0; k < 4; ++k) {
+				allEmpty = allEmpty && kids[k].kind == NodeKind::EmptyLeaf;
+				largest = std::max(largest, kids[k].largestFree);
+			}
+
+			if (allEmpty) {
+				freeGroups.push_back(node.children);
+				node = Node{ NodeKind::EmptyLeaf, 0, length };
+			}
+			else {
+				node.largestFree = largest;
+			}
+		}
+	}
+
+	std::optional<RectI> TextureAtlasAllocator::allocate(const glm::ivec2& size) {
+		assert(size.x > 0 && size.y > 0);
+		uint32_t requested = nextPowerOfTwo(static_cast<uint32_t>(std::max(size.x, size.y)));
+		if (requested > nodes[0].largestFree) {
+			return std::nullopt;
+		}
+
+		uint32_t path[MaxTreeDepth];
+		int depth = 0;
+		uint32_t index = 0, length = rootLength;
+		glm::ivec2 origin{ 0, 0 };
+
+		while (true) {
+			if (nodes[index].kind == NodeKind::EmptyLeaf) {
+				if (length == requested) {
+					break;
+				}
+				// Split, nodes may move.
+				uint32_t children = allocateGroup(length / 2);
+				nodes[index].kind = NodeKind::Parent;
+				nodes[index].children = children;
+			}
+
+			// The first child, in reading order, that has room.
+			path[depth++] = index;
+			length /= 2;
+			uint32_t first = nodes[index].children;
+			int k = 0;
+			while (nodes[first + k].largestFree < requested) {
+				++k;
+				assert(k < 4);
+			}
+
+			index = first + k;
+			origin += glm::ivec2{ (k & 1) ? length : 0, (k & 2) ? length : 0 };
+		}
+
+		nodes[index] = Node{ NodeKind::FullLeaf, 0, 0 };
+		used += static_cast<uint64_t>(length) * length;
+		updateAncestors(path, depth, length);
+
+		int side = static_cast<int>(length);
+		return RectI::fromOriginSize(origin, glm::ivec2{ side, side });
+	}
+
+	void TextureAtlasAllocator::free(const RectI& rect) {
+		uint32_t requested = static_cast<uint32_t>(rect.width());
+		glm::ivec2 target = rect.origin();
+
+		uint32_t path[MaxTreeDepth];
+		int depth = 0;
+		uint32_t index = 0, length = rootLength;
+		glm::ivec2 origin{ 0, 0 };
+
+		while (length > requested) {
+			if (nodes[index].kind != NodeKind::Parent) {
+				assert(false && "Freeing a rect that was not allocated");
+				return;
+			}
+
+			path[depth++] = index;
+			length /= 2;
+			int k = (target.x >= origin.x + static_cast<int>(length) ? 1 : 0) |
+				(target.y >= origin.y + static_cast<int>(length) ? 2 : 0);
+			origin += glm::ivec2{ (k & 1) ? length : 0, (k & 2) ? length : 0 };
+			index = nodes[index].children + k;
+		}
+
+		if (length != requested || origin != target || nodes[index].kind != NodeKind::FullLeaf) {
+			assert(false && "Freeing a rect that was not allocated");
+			return;
+		}
+
+		nodes[index] = Node{ NodeKind::EmptyLeaf, 0, length };
+		used -= static_cast<uint64_t>(length) * length;
+		updateAncestors(path, depth, length);
+	}
+
+	TextureLocation TextureAllocator::allocate(const glm::ivec2& size, AllocationMode mode) {
+		// If requested, or if the image is too big, use a separate page.
+		const int maxLength = static_cast<int>(AtlasTextureLength);
+		if (mode == AllocationMode::OwnPage || size.x > maxLength || size.y > maxLength) {
+			return allocateImage(size);
+		}
+
+		// Try to add to each atlas.
+		for (std::size_t i = 0; i < pages.size(); ++i) {
+			std::optional<TexturePage>& page = pages[i];
+			if (!page || page->kind != TexturePage::Kind::Atlas) {
+				continue;
+			}
+			if (std::optional<RectI> rect = page->atlas.allocate(size)) {
+				return TextureLocation{ static_cast<uint32_t>(i), *rect };
+			}
+		}
+
+		// Add a new atlas.
+		TexturePage page{ TexturePage::Kind::Atlas, glm::ivec2{ maxLength, maxLength }, true, TextureAtlasAllocator{} };
+		std::optional<RectI> rect = page.atlas.allocate(size);
+		assert(rect);
+
+		uint32_t id = firstFreePage();
+		setPage(id, std::move(page));
+		return TextureLocation{ id, *rect };
+	}
+
+	TextureLocation TextureAllocator::allocateImage(const glm::ivec2& size) {
+		uint32_t id = firstFreePage();
+		setPage(id, TexturePage{ TexturePage::Kind::Image, size, true, TextureAtlasAllocator{ 1 } });
+		return TextureLocation{ id, RectI::fromOriginSize(glm::ivec2{ 0, 0 }, size) };
+	}
+
+	void TextureAllocator::free(const TextureLocation& location) {
+		assert(hasPage(location.page) && "Texture page is not allocated");
+		TexturePage& page = *pages[location.page];
+
+		if (page.kind == TexturePage::Kind::Atlas) {
+			page.atlas.free(location.rect);
+			if (!page.atlas.empty()) {
+				// Keep the page around.
+				return;
+			}
+		}
+		else {
+			assert(location.rect.origin() == glm::ivec2(0, 0) && location.rect.size() == page.size);
+		}
+
+		pages[location.page].reset();
+	}
+
+	std::size_t TextureAllocator::pageCount() const noexcept {
+		return pages.size();
+	}
+	bool TextureAllocator::hasPage(uint32_t page) const noexcept {
+		return page < pages.size() && pages[page].has_value();
+	}
+	glm::ivec2 TextureAllocator::pageSize(uint32_t page) const {
+		assert(hasPage(page) && "No such texture page");
+		return pages[page]->size;
+	}
+	glm::vec2 TextureAllocator::pageScale(uint32_t page) const {
+		return glm::vec2{ 1.f } / glm::vec2{ pageSize(page) };
+	}
+	bool TextureAllocator::pageIsNew(uint32_t page) const {
+		assert(hasPage(page) && "No such texture page");
+		return pages[page]->isNew;
+	}
+	void TextureAllocator::markAllPagesAsAllocated() noexcept {
+		for (std::optional<TexturePage>& page : pages) {
+			if (page) {
+				page->isNew = false;
+			}
+		}
+	}
+
+	TextureAllocatorStats TextureAllocator::stats() const noexcept {
+		TextureAllocatorStats result{ 0, 0, 0, 0, 0 };
+		for (const std::optional<TexturePage>& page : pages) {
+			if (!page) {
+				continue;
+			}
+
+			++result.pageCount;
+			if (page->kind != TexturePage::Kind::Atlas) {
+				continue;
+			}
+
+			const TextureAtlasAllocator& atlas = page->atlas;
+			uint64_t area = static_cast<uint64_t>(atlas.length()) * atlas.length();
+			uint64_t largest = static_cast<uint64_t>(atlas.largestFreeLength()) * atlas.largestFreeLength();
+
+			++result.atlasPageCount;
+			result.atlasArea += area;
+			result.usedArea += atlas.usedArea();
+			result.fragmentedArea += area - atlas.usedArea() - largest;
+		}
+		return result;
+	}
+
+	uint32_t TextureAllocator::firstFreePage() const noexcept {
+		for (std::size_t i = 0; i < pages.size(); ++i) {
+			if (!pages[i]) {
+				return static_cast<uint32_t>(i);
+			}
+		}
+		return static_cast<uint32_t>(pages.size());
+	}
+
+	void TextureAllocator::setPage(uint32_t page, TexturePage&& value) {
+		if (page >= pages.size()) {
+			pages.resize(static_cast<std::size_t>(page) + 1);
+		}
+		pages[page] = std::move(value);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+#include <optional>
+
+#include <glm/vec2.hpp>
+
+#include "../geometry/Rect.hpp"
+
+namespace pf {
+	static constexpr uint32_t AtlasTextureLength = 1024;
+
+	struct TextureLocation {
+		uint32_t page;
+		RectI rect;
+	};
+
+	enum class AllocationMode {
+		/// Share an atlas page with other allocations.
+		Atlas,
+		/// Get a page of its own.
+		OwnPage,
+	};
+
+	// Packs squares into a power of two sized atlas with a quadtree. Every node remembers the length of
+	// the largest free square below it, so allocation only descends into subtrees where the request
+	// fits, and both allocating and freeing take time proportional to the depth of the tree.
+	struct TextureAtlasAllocator {
+		TextureAtlasAllocator(uint32_t _length = AtlasTextureLength);
+
+		// The rect is the allocated square, size rounded up to a power of two.
+		std::optional<RectI> allocate(const glm::ivec2& size);
+		// Takes a rect returned by allocate.
+		void free(const RectI& rect);
+
+		bool empty() const noexcept;
+		uint32_t length() const noexcept;
+
+		// Texels covered by allocations.
+		uint64_t usedArea() const noexcept;
+		// Length of the largest square that can still be allocated.
+		uint32_t largestFreeLength() const noexcept;
+		// Zero when all the free space is in a single square, close to one when it is scattered over many
+		// small ones.
+		float fragmentation() const noexcept;
+	private:
+		enum class NodeKind : uint8_t {
+			EmptyLeaf,
+			FullLeaf,
+			Parent,
+		};
+
+		struct Node {
+			NodeKind kind;
+			// Index of the first of the four children of a parent, in the order top left, top right,
+			// bottom left and bottom right.
+			uint32_t children;
+			uint32_t largestFree;
+		};
+
+		uint32_t rootLength;
+		uint64_t used;
+		std::vector<Node> nodes;
+		// Groups of four children freed by merges, reused before growing nodes.
+		std::vector<uint32_t> freeGroups;
+
+		uint32_t allocateGroup(uint32_t childLength);
+		void updateAncestors(const uint32_t* path, int depth, uint32_t length);
+	};
+
+	struct TextureAllocatorStats {
+		uint32_t pageCount, atlasPageCount;
+		// Summed over the atlas pages.
+		uint64_t atlasArea, usedArea;
+		// The free area of the atlas pages that lies outside the largest free square of its page.
+		uint64_t fragmentedArea;
+	};
+
+	// Hands out texture space for mask tiles, glyphs and patterns. Small requests share atlas pages,
+	// large ones get pages of their own. Pages are freed once nothing is left on them, and their ids
+	// are reused.
+	struct TextureAllocator {
+		TextureLocation allocate(const glm::ivec2& size, AllocationMode mode = AllocationMode::Atlas);
+		TextureLocation allocateImage(const glm::ivec2& size);
+		void free(const TextureLocation& location);
+
+		// Number of page ids in use, some of which may currently be free.
+		std::size_t pageCount() const noexcept;
+		bool hasPage(uint32_t page) const noexcept;
+		glm::ivec2 pageSize(uint32_t page) const;
+		glm::vec2 pageScale(uint32_t page) const;
+		// Whether the page was created since the last call to markAllPagesAsAllocated.
+		bool pageIsNew(uint32_t page) const;
+		void markAllPagesAsAllocated() noexcept;
+
+		TextureAllocatorStats stats() const noexcept;
+	private:
+		struct TexturePage {
+			enum class Kind {
+				Atlas,
+				Image,
+			};
+
+			Kind kind;
+			glm::ivec2 size;
+			bool isNew;
+			TextureAtlasAllocator atlas;
+		};
+
+		std::vector<std::optional<TexturePage>> pages;
+
+		uint32_t firstFreePage() const noexcept;
+		void setPage(uint32_t page, TexturePage&& value);
+	};
+};
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "Backdrops.hpp"
+#include "../simd/Simd.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace pf {
+	static_assert(static_cast<uint8_t>(TileKind::Empty) == 0 && static_cast<uint8_t>(TileKind::Solid) == 1,
+		"The kernels build kinds from the inside mask");
+
+	// Windings are stored in a byte. Saturating keeps nonzero windings nonzero, and wrapping keeps
+	// their parity, which is all each rule looks at.
+	template<FillRule Rule>
+	static int8_t narrowWinding(int32_t winding) noexcept {
+		if constexpr (Rule == FillRule::Winding) {
+			return static_cast<int8_t>(std::clamp(winding, -128, 127));
+		}
+		else {
+			return static_cast<int8_t>(static_cast<uint8_t>(winding & 0xFF));
+		}
+	}
+
+	// Each kernel handles the columns [0, count) of one row it can fit whole registers over, and returns
+	// how many that was.
+#if defined(PF_SIMD_SSE2)
+	template<FillRule Rule>
+	static std::size_t propagateRowSSE2(int8_t* backdrops, int32_t* columns, TileKind* kinds, std::size_t count) noexcept {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i one = _mm_set1_epi8(1);
+		const __m128i one32 = _mm_set1_epi32(1);
+		const __m128i alpha = _mm_set1_epi8(static_cast<char>(TileKind::Alpha));
+
+		std::size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m128i delta = _mm_loadu_si128(reinterpret_cast<const __m128i*>(backdrops + i));
+			__m128i* column = reinterpret_cast<__m128i*>(columns + i);
+
+			// Sign extend the deltas to 32 bits.
+			__m128i delta16Lo = _mm_unpacklo_epi8(delta, _mm_cmpgt_epi8(zero, delta));
+			__m128i delta16Hi = _mm_unpackhi_epi8(delta, _mm_cmpgt_epi8(zero, delta));
+			__m128i delta32[4] = {
+				_mm_unpacklo_epi16(delta16Lo, _mm_cmpgt_epi16(zero, delta16Lo)),
+				_mm_unpackhi_epi16(delta16Lo, _mm_cmpgt_epi16(zero, delta16Lo)),
+				_mm_unpacklo_epi16(delta16Hi, _mm_cmpgt_epi16(zero, delta16Hi)),
+				_mm_unpackhi_epi16(delta16Hi, _mm_cmpgt_epi16(zero, delta16Hi)),
+			};
+
+			__m128i winding32[4];
+			for (int j = 0; j < 4; ++j) {
+				winding32[j] = _mm_loadu_si128(column + j);
+				_mm_storeu_si128(column + j, _mm_add_epi32(winding32[j], delta32[j]));
+			}
+
+			// Inside is decided on the full windings, as 1 per byte, which is also TileKind::Solid.
+			__m128i inside, winding;
+			if constexpr (Rule == FillRule::Winding) {
+				__m128i outside = _mm_packs_epi16(
+					_mm_packs_epi32(_mm_cmpeq_epi32(winding32[0], zero), _mm_cmpeq_epi32(winding32[1], zero)),
+					_mm_packs_epi32(_mm_cmpeq_epi32(winding32[2], zero), _mm_cmpeq_epi32(winding32[3], zero)));
+				inside = _mm_andnot_si128(outside, one);
+				winding = _mm_packs_epi16(
+					_mm_packs_epi32(winding32[0], winding32[1]),
+					_mm_packs_epi32(winding32[2], winding32[3]));
+			}
+			else {
+				inside = _mm_packs_epi16(
+					_mm_packs_epi32(_mm_and_si128(winding32[0], one32), _mm_and_si128(winding32[1], one32)),
+					_mm_packs_epi32(_mm_and_si128(winding32[2], one32), _mm_and_si128(winding32[3], one32)));
+				// Sign extending the low byte wraps, so the packs below have nothing to saturate.
+				for (int j = 0; j < 4; ++j) {
+					winding32[j] = _mm_srai_epi32(_mm_slli_epi32(winding32[j], 24), 24);
+				}
+				winding = _mm_packs_epi16(
+					_mm_packs_epi32(winding32[0], winding32[1]),
+					_mm_packs_epi32(winding32[2], winding32[3]));
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(backdrops + i), winding);
+
+			__m128i* kind = reinterpret_cast<__m128i*>(kinds + i);
+			__m128i isAlpha = _mm_cmpeq_epi8(_mm_loadu_si128(kind), alpha);
+			_mm_storeu_si128(kind, _mm_or_si128(_mm_and_si128(isAlpha, alpha), _mm_andnot_si128(isAlpha, inside)));
+		}
+		return i;
+	}
+#elif defined(PF_SIMD_NEON)
+	template<FillRule Rule>
+	static std::size_t propagateRowNEON(int8_t* backdrops, int32_t* columns, TileKind* kinds, std::size_t count) noexcept {
+		const uint8x16_t one = vdupq_n_u8(1);
+		const uint8x16_t alpha = vdupq_n_u8(static_cast<uint8_t>(TileKind::Alpha));
+
+		std::size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			int8x16_t delta = vld1q_s8(backdrops + i);
+			int16x8_t delta16Lo = vmovl_s8(vget_low_s8(delta)), delta16Hi = vmovl_s8(vget_high_s8(delta));
+			int32x4_t delta32[4] = {
+				vmovl_s16(vget_low_s16(delta16Lo)),
+				vmovl_s16(vget_high_s16(delta16Lo)),
+				vmovl_s16(vget_low_s16(delta16Hi)),
+				vmovl_s16(vget_high_s16(delta16Hi)),
+			};
+
+			int32x4_t winding32[4];
+			for (int j = 0; j < 4; ++j) {
+				winding32[j] = vld1q_s32(columns + i + 4 * j);
+				vst1q_s32(columns + i + 4 * j, vaddq_s32(winding32[j], delta32[j]));
+			}
+
+			// Inside is decided on the full windings, as 1 per byte, which is also TileKind::Solid.
+			uint32x4_t inside32[4];
+			for (int j = 0; j < 4; ++j) {
+				if constexpr (Rule == FillRule::Winding) {
+					inside32[j] = vtstq_s32(winding32[j], winding32[j]);
+				}
+				else {
+					inside32[j] = vreinterpretq_u32_s32(vandq_s32(winding32[j], vdupq_n_s32(1)));
+				}
+			}
+			uint8x16_t inside = vandq_u8(one, vcombine_u8(
+				vmovn_u16(vcombine_u16(vmovn_u32(inside32[0]), vmovn_u32(inside32[1]))),
+				vmovn_u16(vcombine_u16(vmovn_u32(inside32[2]), vmovn_u32(inside32[3])))));
+
+			int8x16_t winding;
+			if constexpr (Rule == FillRule::Winding) {
+				winding = vcombine_s8(
+					vqmovn_s16(vcombine_s16(vqmovn_s32(winding32[0]), vqmovn_s32(winding32[1]))),
+					vqmovn_s16(vcombine_s16(vqmovn_s32(winding32[2]), vqmovn_s32(winding32[3]))));
+			}
+			else {
+				winding = vcombine_s8(
+					vmovn_s16(vcombine_s16(vmovn_s32(winding32[0]), vmovn_s32(winding32[1]))),
+					vmovn_s16(vcombine_s16(vmovn_s32(winding32[2]), vmovn_s32(winding32[3]))));
+			}
+			vst1q_s8(backdrops + i, winding);
+
+			uint8_t* kind = reinterpret_cast<uint8_t*>(kinds + i);
+			uint8x16_t isAlpha = vceqq_u8(vld1q_u8(kind), alpha);
+			vst1q_u8(kind, vbslq_u8(isAlpha, alpha, inside));
+		}
+		return i;
+	}
+#endif
+
+	template<FillRule Rule>
+	static void propagateRow(int8_t* backdrops, int32_t* columns, TileKind* kinds, std::size_t count) noexcept {
+		std::size_t i = 0;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			i = propagateRowSSE2<Rule>(backdrops, columns, kinds, count);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = propagateRowNEON<Rule>(backdrops, columns, kinds, count);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i < count; ++i) {
+			int32_t winding = columns[i];
+			columns[i] += backdrops[i];
+			backdrops[i] = narrowWinding<Rule>(winding);
+
+			if (kinds[i] != TileKind::Alpha) {
+				kinds[i] = windingIsInside<Rule>(winding) ? TileKind::Solid : TileKind::Empty;
+			}
+		}
+	}
+
+	template<FillRule Rule>
+	static void propagateBackdropsImpl(DenseTileMap<int8_t>& backdrops, std::vector<int32_t>& columns, DenseTileMap<TileKind>& kinds) noexcept {
+		const std::size_t count = static_cast<std::size_t>(backdrops.rect.width());
+		for (int y = backdrops.rect.minY(); y < backdrops.rect.maxY(); ++y) {
+			propagateRow<Rule>(backdrops.row(y), columns.data(), kinds.row(y), count);
+		}
+	}
+
+	void propagateBackdrops(DenseTileMap<int8_t>& backdrops, std::vector<int32_t>& columns, FillRule rule, DenseTileMap<TileKind>& kinds) noexcept {
+		assert(backdrops.size() == kinds.size());
+		assert(columns.size() == static_cast<std::size_t>(std::max(backdrops.rect.width(), 0)));
+		if (backdrops.empty()) {
+			return;
+		}
+
+		if (rule == FillRule::EvenOdd) {
+			propagateBackdropsImpl<FillRule::EvenOdd>(backdrops, columns, kinds);
+		}
+		else {
+			propagateBackdropsImpl<FillRule::Winding>(backdrops, columns, kinds);
+		}
+	}
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include "../content/Fill.hpp"
+
+#include "Tiles.hpp"
+#include "TileMap.hpp"
+
+namespace pf {
+	// Sums backdrop deltas down every column of tiles, one row at a time with the columns spread
+	// over SIMD lanes, and classifies each tile in the same sweep.
+	//
+	// backdrops holds the delta of each tile on input, and the winding number of the tile on output,
+	// narrowed to the int8 range without changing what the rule makes of it: saturated for nonzero,
+	// wrapped for even-odd. columns holds the winding above the first row for every column,
+	// and the winding below the last row afterwards. kinds must be Alpha for the tiles that have fills
+	// and Empty elsewhere; the tiles without fills become Solid where the rule puts them inside.
+	void propagateBackdrops(DenseTileMap<int8_t>& backdrops, std::vector<int32_t>& columns, FillRule rule, DenseTileMap<TileKind>& kinds) noexcept;
+};
\ No newline at end of file
@@ -0,0 +1,484 @@
+#include "Blend.hpp"
+#include "../simd/Simd.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+namespace pf {
+	// Four floats and the masks that select between them, on whatever the target compiles in. The
+	// kernels below are written once against these.
+#if defined(PF_SIMD_SSE2)
+	struct F4 {
+		__m128 v;
+	};
+	struct M4 {
+		__m128 v;
+	};
+
+	static F4 splat(float value) noexcept { return F4{ _mm_set1_ps(value) }; }
+	static F4 load(const float* values) noexcept { return F4{ _mm_loadu_ps(values) }; }
+	static void store(F4 value, float* values) noexcept { _mm_storeu_ps(values, value.v); }
+
+	static F4 operator+(F4 lh, F4 rh) noexcept { return F4{ _mm_add_ps(lh.v, rh.v) }; }
+	static F4 operator-(F4 lh, F4 rh) noexcept { return F4{ _mm_sub_ps(lh.v, rh.v) }; }
+	static F4 operator*(F4 lh, F4 rh) noexcept { return F4{ _mm_mul_ps(lh.v, rh.v) }; }
+	static F4 operator/(F4 lh, F4 rh) noexcept { return F4{ _mm_div_ps(lh.v, rh.v) }; }
+	static F4 min(F4 lh, F4 rh) noexcept { return F4{ _mm_min_ps(lh.v, rh.v) }; }
+	static F4 max(F4 lh, F4 rh) noexcept { return F4{ _mm_max_ps(lh.v, rh.v) }; }
+	static F4 abs(F4 value) noexcept { return F4{ _mm_andnot_ps(_mm_set1_ps(-0.f), value.v) }; }
+	static F4 sqrt(F4 value) noexcept { return F4{ _mm_sqrt_ps(value.v) }; }
+
+	static M4 operator<(F4 lh, F4 rh) noexcept { return M4{ _mm_cmplt_ps(lh.v, rh.v) }; }
+	static M4 operator<=(F4 lh, F4 rh) noexcept { return M4{ _mm_cmple_ps(lh.v, rh.v) }; }
+	static M4 operator>(F4 lh, F4 rh) noexcept { return M4{ _mm_cmpgt_ps(lh.v, rh.v) }; }
+	static M4 operator>=(F4 lh, F4 rh) noexcept { return M4{ _mm_cmpge_ps(lh.v, rh.v) }; }
+	static M4 operator&&(M4 lh, M4 rh) noexcept { return M4{ _mm_and_ps(lh.v, rh.v) }; }
+	static M4 operator||(M4 lh, M4 rh) noexcept { return M4{ _mm_or_ps(lh.v, rh.v) }; }
+	// Lanes of a where mask is set, of b elsewhere.
+	static F4 select(M4 mask, F4 a, F4 b) noexcept { return F4{ _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+#elif defined(PF_SIMD_NEON)
+	struct F4 {
+		float32x4_t v;
+	};
+	struct M4 {
+		uint32x4_t v;
+	};
+
+	static F4 splat(float value) noexcept { return F4{ vdupq_n_f32(value) }; }
+	static F4 load(const float* values) noexcept { return F4{ vld1q_f32(values) }; }
+	static void store(F4 value, float* values) noexcept { vst1q_f32(values, value.v); }
+
+	static F4 operator+(F4 lh, F4 rh) noexcept { return F4{ vaddq_f32(lh.v, rh.v) }; }
+	static F4 operator-(F4 lh, F4 rh) noexcept { return F4{ vsubq_f32(lh.v, rh.v) }; }
+	static F4 operator*(F4 lh, F4 rh) noexcept { return F4{ vmulq_f32(lh.v, rh.v) }; }
+	static F4 operator/(F4 lh, F4 rh) noexcept { return F4{ vdivq_f32(lh.v, rh.v) }; }
+	static F4 min(F4 lh, F4 rh) noexcept { return F4{ vminq_f32(lh.v, rh.v) }; }
+	static F4 max(F4 lh, F4 rh) noexcept { return F4{ vmaxq_f32(lh.v, rh.v) }; }
+	static F4 abs(F4 value) noexcept { return F4{ vabsq_f32(value.v) }; }
+	static F4 sqrt(F4 value) noexcept { return F4{ vsqrtq_f32(value.v) }; }
+
+	static M4 operator<(F4 lh, F4 rh) noexcept { return M4{ vcltq_f32(lh.v, rh.v) }; }
+	static M4 operator<=(F4 lh, F4 rh) noexcept { return M4{ vcleq_f32(lh.v, rh.v) }; }
+	static M4 operator>(F4 lh, F4 rh) noexcept { return M4{ vcgtq_f32(lh.v, rh.v) }; }
+	static M4 operator>=(F4 lh, F4 rh) noexcept { return M4{ vcgeq_f32(lh.v, rh.v) }; }
+	static M4 operator&&(M4 lh, M4 rh) noexcept { return M4{ vandq_u32(lh.v, rh.v) }; }
+	static M4 operator||(M4 lh, M4 rh) noexcept { return M4{ vorrq_u32(lh.v, rh.v) }; }
+	static F4 select(M4 mask, F4 a, F4 b) noexcept { return F4{ vbslq_f32(mask.v, a.v, b.v) }; }
+#else
+	struct F4 {
+		float v[4];
+	};
+	struct M4 {
+		bool v[4];
+	};
+
+	template<typename F>
+	static F4 lanes(F&& f) noexcept {
+		return F4{ { f(0), f(1), f(2), f(3) } };
+	}
+	template<typename F>
+	static M4 maskLanes(F&& f) noexcept {
+		return M4{ { f(0), f(1), f(2), f(3) } };
+	}
+
+	static F4 splat(float value) noexcept { return F4{ { value, value, value, value } }; }
+	static F4 load(const float* values) noexcept { return F4{ { values[0], values[1], values[2], values[3] } }; }
+	static void store(F4 value, float* values) noexcept { std::memcpy(values, value.v, sizeof(value.v)); }
+
+	static F4 operator+(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return lh.v[i] + rh.v[i]; }); }
+	static F4 operator-(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return lh.v[i] - rh.v[i]; }); }
+	static F4 operator*(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return lh.v[i] * rh.v[i]; }); }
+	static F4 operator/(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return lh.v[i] / rh.v[i]; }); }
+	static F4 min(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return std::min(lh.v[i], rh.v[i]); }); }
+	static F4 max(F4 lh, F4 rh) noexcept { return lanes([&](int i) { return std::max(lh.v[i], rh.v[i]); }); }
+	static F4 abs(F4 value) noexcept { return lanes([&](int i) { return std::abs(value.v[i]); }); }
+	static F4 sqrt(F4 value) noexcept { return lanes([&](int i) { return std::sqrt(value.v[i]); }); }
+
+	static M4 operator<(F4 lh, F4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] < rh.v[i]; }); }
+	static M4 operator<=(F4 lh, F4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] <= rh.v[i]; }); }
+	static M4 operator>(F4 lh, F4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] > rh.v[i]; }); }
+	static M4 operator>=(F4 lh, F4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] >= rh.v[i]; }); }
+	static M4 operator&&(M4 lh, M4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] && rh.v[i]; }); }
+	static M4 operator||(M4 lh, M4 rh) noexcept { return maskLanes([&](int i) { return lh.v[i] || rh.v[i]; }); }
+	static F4 select(M4 mask, F4 a, F4 b) noexcept { return lanes([&](int i) { return mask.v[i] ? a.v[i] : b.v[i]; }); }
+#endif
+
+	// One channel per member, one pixel per lane.
+	struct Pixels {
+		F4 r, g, b, a;
+	};
+
+	static constexpr bool isPorterDuff(BlendMode mode) noexcept {
+		return mode <= BlendMode::Lighter;
+	}
+	static constexpr bool isSeparable(BlendMode mode) noexcept {
+		return mode < BlendMode::Hue;
+	}
+
+	// Porter-Duff modes are result = source * sourceFactor + destination * destinationFactor.
+	template<BlendMode Mode>
+	static F4 sourceFactor(F4 sourceAlpha, F4 destinationAlpha) noexcept {
+		(void)sourceAlpha;
+		const F4 zero = splat(0.f), one = splat(1.f);
+		if constexpr (Mode == BlendMode::Clear || Mode == BlendMode::DestIn || Mode == BlendMode::DestOut) {
+			return zero;
+		}
+		else if constexpr (Mode == BlendMode::Copy || Mode == BlendMode::SrcOver || Mode == BlendMode::Lighter) {
+			return one;
+		}
+		else if constexpr (Mode == BlendMode::SrcIn || Mode == BlendMode::SrcAtop) {
+			return destinationAlpha;
+		}
+		else {
+			// SrcOut, DestOver, DestAtop and Xor.
+			return one - destinationAlpha;
+		}
+	}
+	template<BlendMode Mode>
+	static F4 destinationFactor(F4 sourceAlpha, F4 destinationAlpha) noexcept {
+		(void)destinationAlpha;
+		const F4 zero = splat(0.f), one = splat(1.f);
+		if constexpr (Mode == BlendMode::Clear || Mode == BlendMode::Copy || Mode == BlendMode::SrcIn || Mode == BlendMode::SrcOut) {
+			return zero;
+		}
+		else if constexpr (Mode == BlendMode::DestOver || Mode == BlendMode::Lighter) {
+			return one;
+		}
+		else if constexpr (Mode == BlendMode::DestIn || Mode == BlendMode::DestAtop) {
+			return sourceAlpha;
+		}
+		else {
+			// SrcOver, SrcAtop, DestOut and Xor.
+			return one - sourceAlpha;
+		}
+	}
+
+	// The separable blend functions B(cb, cs) on unpremultiplied channels.
+	template<BlendMode Mode>
+	static F4 blendChannel(F4 cb, F4 cs) noexcept {
+		const F4 zero = splat(0.f), half = splat(0.5f), one = splat(1.f), two = splat(2.f);
+		if constexpr (Mode == BlendMode::Darken) {
+			return min(cb, cs);
+		}
+		else if constexpr (Mode == BlendMode::Lighten) {
+			return max(cb, cs);
+		}
+		else if constexpr (Mode == BlendMode::Multiply) {
+			return cb * cs;
+		}
+		else if constexpr (Mode == BlendMode::Screen) {
+			return cb + cs - cb * cs;
+		}
+		else if constexpr (Mode == BlendMode::HardLight) {
+			return select(cs <= half, blendChannel<BlendMode::Multiply>(cb, two * cs), blendChannel<BlendMode::Screen>(cb, two * cs - one));
+		}
+		else if constexpr (Mode == BlendMode::Overlay) {
+			return blendChannel<BlendMode::HardLight>(cs, cb);
+		}
+		else if constexpr (Mode == BlendMode::ColorDodge) {
+			F4 dodged = min(one, cb / (one - cs));
+			return select(cb <= zero, zero, select(cs >= one, one, dodged));
+		}
+		else if constexpr (Mode == BlendMode::ColorBurn) {
+			F4 burned = one - min(one, (one - cb) / cs);
+			return select(cb >= one, one, select(cs <= zero, zero, burned));
+		}
+		else if constexpr (Mode == BlendMode::SoftLight) {
+			F4 d = select(cb <= splat(0.25f), ((splat(16.f) * cb - splat(12.f)) * cb + splat(4.f)) * cb, sqrt(max(cb, zero)));
+			F4 darker = cb - (one - two * cs) * cb * (one - cb);
+			F4 lighter = cb + (two * cs - one) * (d - cb);
+			return select(cs <= half, darker, lighter);
+		}
+		else if constexpr (Mode == BlendMode::Difference) {
+			return abs(cb - cs);
+		}
+		else {
+			static_assert(Mode == BlendMode::Exclusion, "Not a separable blend mode");
+			return cb + cs - two * cb * cs;
+		}
+	}
+
+	struct Rgb {
+		F4 r, g, b;
+	};
+
+	static F4 lum(const Rgb& c) noexcept {
+		return splat(0.3f) * c.r + splat(0.59f) * c.g + splat(0.11f) * c.b;
+	}
+	static F4 sat(const Rgb& c) noexcept {
+		return max(max(c.r, c.g), c.b) - min(min(c.r, c.g), c.b);
+	}
+
+	static Rgb clipColor(const Rgb& c) noexcept {
+		const F4 zero = splat(0.f), one = splat(1.f);
+		F4 l = lum(c);
+		F4 n = min(min(c.r, c.g), c.b);
+		F4 x = max(max(c.r, c.g), c.b);
+
+		M4 low = n < zero, high = x > one;
+
+		// Both clips use the extremes of the input, as in the spec.
+		auto clip = [&](F4 channel) {
+			channel = select(low, l + (channel - l) * l / (l - n), channel);
+			return select(high, l + (channel - l) * (one - l) / (x - l), channel);
+		};
+		return Rgb{ clip(c.r), clip(c.g), clip(c.b) };
+	}
+
+	static Rgb setLum(const Rgb& c, F4 l) noexcept {
+		F4 d = l - lum(c);
+		return clipColor(Rgb{ c.r + d, c.g + d, c.b + d });
+	}
+
+	static Rgb setSat(const Rgb& c, F4 s) noexcept {
+		const F4 zero = splat(0.f);
+		F4 n = min(min(c.r, c.g), c.b);
+		F4 x = max(max(c.r, c.g), c.b);
+		F4 range = x - n;
+		M4 flat = range <= zero;
+
+		// Scales the channels so that min goes to zero and max to s, which puts mid in between.
+		auto scale = [&](F4 channel) {
+			return select(flat, zero, (channel - n) * s / range);
+		};
+		return Rgb{ scale(c.r), scale(c.g), scale(c.b) };
+	}
+
+	template<BlendMode Mode>
+	static Rgb blendColor(const Rgb& cb, const Rgb& cs) noexcept {
+		if constexpr (Mode == BlendMode::Hue) {
+			return setLum(setSat(cs, sat(cb)), lum(cb));
+		}
+		else if constexpr (Mode == BlendMode::Saturation) {
+			return setLum(setSat(cb, sat(cs)), lum(cb));
+		}
+		else if constexpr (Mode == BlendMode::Color) {
+			return setLum(cs, lum(cb));
+		}
+		else {
+			static_assert(Mode == BlendMode::Luminosity, "Not a non-separable blend mode");
+			return setLum(cb, lum(cs));
+		}
+	}
+
+	template<BlendMode Mode>
+	static Pixels blendPixels(const Pixels& s, const Pixels& d) noexcept {
+		const F4 zero = splat(0.f), one = splat(1.f);
+
+		if constexpr (isPorterDuff(Mode)) {
+			F4 fs = sourceFactor<Mode>(s.a, d.a), fd = destinationFactor<Mode>(s.a, d.a);
+			Pixels result{ s.r * fs + d.r * fd, s.g * fs + d.g * fd, s.b * fs + d.b * fd, s.a * fs + d.a * fd };
+			if constexpr (Mode == BlendMode::Lighter) {
+				result = Pixels{ min(result.r, one), min(result.g, one), min(result.b, one), min(result.a, one) };
+			}
+			return result;
+		}
+		else {
+			// co = cs * (1 - ab) + cb * (1 - as) + as * ab * B(cb / ab, cs / as), all premultiplied.
+			M4 sourceCovered = s.a > zero, destinationCovered = d.a > zero;
+			Rgb cs{ select(sourceCovered, s.r / s.a, zero), select(sourceCovered, s.g / s.a, zero), select(sourceCovered, s.b / s.a, zero) };
+			Rgb cb{ select(destinationCovered, d.r / d.a, zero), select(destinationCovered, d.g / d.a, zero), select(destinationCovered, d.b / d.a, zero) };
+
+			Rgb mixed;
+			if constexpr (isSeparable(Mode)) {
+				mixed = Rgb{ blendChannel<Mode>(cb.r, cs.r), blendChannel<Mode>(cb.g, cs.g), blendChannel<Mode>(cb.b, cs.b) };
+			}
+			else {
+				mixed = blendColor<Mode>(cb, cs);
+			}
+
+			F4 both = s.a * d.a;
+			F4 sourceOnly = one - d.a, destinationOnly = one - s.a;
+			return Pixels{
+				s.r * sourceOnly + d.r * destinationOnly + both * mixed.r,
+				s.g * sourceOnly + d.g * destinationOnly + both * mixed.g,
+				s.b * sourceOnly + d.b * destinationOnly + both * mixed.b,
+				s.a + d.a - both,
+			};
+		}
+	}
+
+	// Four RGBA8 pixels, deinterleaved into channels in [0, 1].
+#if defined(PF_SIMD_SSE2)
+	static Pixels loadRGBA8(const uint8_t* pixels) noexcept {
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+		const __m128i low = _mm_set1_epi32(0xFF);
+		const __m128 scale = _mm_set1_ps(1.f / 255.f);
+		return Pixels{
+			F4{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(bytes, low)), scale) },
+			F4{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(bytes, 8), low)), scale) },
+			F4{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(bytes, 16), low)), scale) },
+			F4{ _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bytes, 24)), scale) },
+		};
+	}
+
+	// Rounds to nearest even, like the scalar path.
+	static __m128i toByte(F4 channel) noexcept {
+		__m128 clamped = _mm_min_ps(_mm_max_ps(channel.v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+		return _mm_cvtps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255.f)));
+	}
+	static void storeRGBA8(const Pixels& p, uint8_t* pixels) noexcept {
+		__m128i packed = _mm_or_si128(
+			_mm_or_si128(toByte(p.r), _mm_slli_epi32(toByte(p.g), 8)),
+			_mm_or_si128(_mm_slli_epi32(toByte(p.b), 16), _mm_slli_epi32(toByte(p.a), 24)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), packed);
+	}
+#else
+	static Pixels loadRGBA8(const uint8_t* pixels) noexcept {
+		float channels[4][4];
+		for (int i = 0; i < 4; ++i) {
+			for (int c = 0; c < 4; ++c) {
+				channels[c][i] = static_cast<float>(pixels[4 * i + c]) * (1.f / 255.f);
+			}
+		}
+		return Pixels{ load(channels[0]), load(channels[1]), load(channels[2]), load(channels[3]) };
+	}
+	static void storeRGBA8(const Pixels& p, uint8_t* pixels) noexcept {
+		float channels[4][4];
+		store(p.r, channels[0]);
+		store(p.g, channels[1]);
+		store(p.b, channels[2]);
+		store(p.a, channels[3]);
+		for (int i = 0; i < 4; ++i) {
+			for (int c = 0; c < 4; ++c) {
+				float value = std::clamp(channels[c][i], 0.f, 1.f) * 255.f;
+				pixels[4 * i + c] = static_cast<uint8_t>(std::nearbyint(value));
+			}
+		}
+	}
+#endif
+
+	// Four RGBA16F pixels. Halves are converted one by one, the blending itself stays in lanes.
+	static Pixels loadRGBA16F(const half* pixels) noexcept {
+		float channels[4][4];
+		for (int i = 0; i < 4; ++i) {
+			for (int c = 0; c < 4; ++c) {
+				channels[c][i] = static_cast<float>(pixels[4 * i + c]);
+			}
+		}
+		return Pixels{ load(channels[0]), load(channels[1]), load(channels[2]), load(channels[3]) };
+	}
+	static void storeRGBA16F(const Pixels& p, half* pixels) noexcept {
+		float channels[4][4];
+		store(p.r, channels[0]);
+		store(p.g, channels[1]);
+		store(p.b, channels[2]);
+		store(p.a, channels[3]);
+		for (int i = 0; i < 4; ++i) {
+			for (int c = 0; c < 4; ++c) {
+				pixels[4 * i + c] = half{ channels[c][i] };
+			}
+		}
+	}
+
+	// Runs blend over the span four pixels at a time. The last partial group goes through a zero padded
+	// copy, so every pixel takes the same path.
+	template<typename T, typename Load, typename Store, typename Blend>
+	static void blendGroups(const T* source, T* destination, std::size_t count, Load&& loadPixels, Store&& storePixels, Blend&& blend) noexcept {
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			storePixels(blend(loadPixels(source + 4 * i), loadPixels(destination + 4 * i)), destination + 4 * i);
+		}
+
+		std::size_t rest = count - i;
+		if (rest == 0) {
+			return;
+		}
+
+		T sourceTail[16] = {}, destinationTail[16] = {};
+		std::copy(source + 4 * i, source + 4 * count, sourceTail);
+		std::copy(destination + 4 * i, destination + 4 * count, destinationTail);
+		storePixels(blend(loadPixels(sourceTail), loadPixels(destinationTail)), destinationTail);
+		std::copy(destinationTail, destinationTail + 4 * rest, destination + 4 * i);
+	}
+
+	template<BlendMode Mode>
+	void blendSpan(const uint8_t* source, uint8_t* destination, std::size_t count) noexcept {
+		blendGroups(source, destination, count, loadRGBA8, storeRGBA8, blendPixels<Mode>);
+	}
+	template<BlendMode Mode>
+	void blendSpan(const half* source, half* destination, std::size_t count) noexcept {
+		blendGroups(source, destination, count, loadRGBA16F, storeRGBA16F, blendPixels<Mode>);
+	}
+
+	// Calls f with the mode as a compile time constant.
+	template<typename F>
+	static void withBlendMode(BlendMode mode, F&& f) noexcept {
+		switch (mode) {
+		case BlendMode::Clear: f(std::integral_constant<BlendMode, BlendMode::Clear>{}); break;
+		case BlendMode::Copy: f(std::integral_constant<BlendMode, BlendMode::Copy>{}); break;
+		case BlendMode::SrcIn: f(std::integral_constant<BlendMode, BlendMode::SrcIn>{}); break;
+		case BlendMode::SrcOut: f(std::integral_constant<BlendMode, BlendMode::SrcOut>{}); break;
+		case BlendMode::SrcOver: f(std::integral_constant<BlendMode, BlendMode::SrcOver>{}); break;
+		case BlendMode::SrcAtop: f(std::integral_constant<BlendMode, BlendMode::SrcAtop>{}); break;
+		case BlendMode::DestIn: f(std::integral_constant<BlendMode, BlendMode::DestIn>{}); break;
+		case BlendMode::DestOut: f(std::integral_constant<BlendMode, BlendMode::DestOut>{}); break;
+		case BlendMode::DestOver: f(std::integral_constant<BlendMode, BlendMode::DestOver>{}); break;
+		case BlendMode::DestAtop: f(std::integral_constant<BlendMode, BlendMode::DestAtop>{}); break;
+		case BlendMode::Xor: f(std::integral_constant<BlendMode, BlendMode::Xor>{}); break;
+		case BlendMode::Lighter: f(std::integral_constant<BlendMode, BlendMode::Lighter>{}); break;
+		case BlendMode::Darken: f(std::integral_constant<BlendMode, BlendMode::Darken>{}); break;
+		case BlendMode::Lighten: f(std::integral_constant<BlendMode, BlendMode::Lighten>{}); break;
+		case BlendMode::Multiply: f(std::integral_constant<BlendMode, BlendMode::Multiply>{}); break;
+		case BlendMode::Screen: f(std::integral_constant<BlendMode, BlendMode::Screen>{}); break;
+		case BlendMode::HardLight: f(std::integral_constant<BlendMode, BlendMode::HardLight>{}); break;
+		case BlendMode::Overlay: f(std::integral_constant<BlendMode, BlendMode::Overlay>{}); break;
+		case BlendMode::ColorDodge: f(std::integral_constant<BlendMode, BlendMode::ColorDodge>{}); break;
+		case BlendMode::ColorBurn: f(std::integral_constant<BlendMode, BlendMode::ColorBurn>{}); break;
+		case BlendMode::SoftLight: f(std::integral_constant<BlendMode, BlendMode::SoftLight>{}); break;
+		case BlendMode::Difference: f(std::integral_constant<BlendMode, BlendMode::Difference>{}); break;
+		case BlendMode::Exclusion: f(std::integral_constant<BlendMode, BlendMode::Exclusion>{}); break;
+		case BlendMode::Hue: f(std::integral_constant<BlendMode, BlendMode::Hue>{}); break;
+		case BlendMode::Saturation: f(std::integral_constant<BlendMode, BlendMode::Saturation>{}); break;
+		case BlendMode::Color: f(std::integral_constant<BlendMode, BlendMode::Color>{}); break;
+		case BlendMode::Luminosity: f(std::integral_constant<BlendMode, BlendMode::Luminosity>{}); break;
+		}
+	}
+
+	void blendSpan(BlendMode mode, const uint8_t* source, uint8_t* destination, std::size_t count) noexcept {
+		withBlendMode(mode, [&](auto constant) {
+			blendSpan<decltype(constant)::value>(source, destination, count);
+		});
+	}
+	void blendSpan(BlendMode mode, const half* source, half* destination, std::size_t count) noexcept {
+		withBlendMode(mode, [&](auto constant) {
+			blendSpan<decltype(constant)::value>(source, destination, count);
+		});
+	}
+
+#define PF_INSTANTIATE_BLEND(mode) \
+	template void blendSpan<BlendMode::mode>(const uint8_t*, uint8_t*, std::size_t) noexcept; \
+	template void blendSpan<BlendMode::mode>(const half*, half*, std::size_t) noexcept;
+
+	PF_INSTANTIATE_BLEND(Clear)
+	PF_INSTANTIATE_BLEND(Copy)
+	PF_INSTANTIATE_BLEND(SrcIn)
+	PF_INSTANTIATE_BLEND(SrcOut)
+	PF_INSTANTIATE_BLEND(SrcOver)
+	PF_INSTANTIATE_BLEND(SrcAtop)
+	PF_INSTANTIATE_BLEND(DestIn)
+	PF_INSTANTIATE_BLEND(DestOut)
+	PF_INSTANTIATE_BLEND(DestOver)
+	PF_INSTANTIATE_BLEND(DestAtop)
+	PF_INSTANTIATE_BLEND(Xor)
+	PF_INSTANTIATE_BLEND(Lighter)
+	PF_INSTANTIATE_BLEND(Darken)
+	PF_INSTANTIATE_BLEND(Lighten)
+	PF_INSTANTIATE_BLEND(Multiply)
+	PF_INSTANTIATE_BLEND(Screen)
+	PF_INSTANTIATE_BLEND(HardLight)
+	PF_INSTANTIATE_BLEND(Overlay)
+	PF_INSTANTIATE_BLEND(ColorDodge)
+	PF_INSTANTIATE_BLEND(ColorBurn)
+	PF_INSTANTIATE_BLEND(SoftLight)
+	PF_INSTANTIATE_BLEND(Difference)
+	PF_INSTANTIATE_BLEND(Exclusion)
+	PF_INSTANTIATE_BLEND(Hue)
+	PF_INSTANTIATE_BLEND(Saturation)
+	PF_INSTANTIATE_BLEND(Color)
+	PF_INSTANTIATE_BLEND(Luminosity)
+
+#undef PF_INSTANTIATE_BLEND
+};
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+#include <cinttypes>
+
+#include "../content/Effects.hpp"
+#include "../gpu/half.hpp"
+
+namespace pf {
+	// Composites count premultiplied RGBA source pixels onto the premultiplied destination, in place,
+	// with the formulas of the W3C compositing and blending spec. Each mode gets its own instantiation,
+	// so the inner loop has no switch. Pixels are processed four at a time with the channels spread
+	// over SIMD lanes.
+	//
+	// Instantiated for every BlendMode in Blend.cpp.
+	template<BlendMode Mode>
+	void blendSpan(const uint8_t* source, uint8_t* destination, std::size_t count) noexcept;
+	template<BlendMode Mode>
+	void blendSpan(const half* source, half* destination, std::size_t count) noexcept;
+
+	// Picks the instantiation for mode once per span.
+	void blendSpan(BlendMode mode, const uint8_t* source, uint8_t* destination, std::size_t count) noexcept;
+	void blendSpan(BlendMode mode, const half* source, half* destination, std::size_t count) noexcept;
+};
\ No newline at end of file
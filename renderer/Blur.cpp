@@ -0,0 +1,223 @@
+#include "Blur.hpp"
+#include "../simd/Simd.hpp"
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+
+namespace pf {
+	// Lines handed to a task at once, so that a vertical pass walks through whole cache lines.
+	static constexpr std::size_t LinesPerTask = 16;
+
+	// A row or a column of the image.
+	struct BlurLine {
+		const uint8_t* source;
+		uint8_t* destination;
+		std::ptrdiff_t step;
+		std::size_t length;
+	};
+
+	// The normalized weights of the Gaussian over [-radius, radius].
+	static std::vector<float> gaussianWeights(float sigma) {
+		int radius = static_cast<int>(std::ceil(3.f * sigma));
+		std::vector<float> weights(2 * static_cast<std::size_t>(radius) + 1);
+
+		float sum = 0.f;
+		for (int k = -radius; k <= radius; ++k) {
+			float weight = std::exp(-static_cast<float>(k * k) / (2.f * sigma * sigma));
+			weights[k + radius] = weight;
+			sum += weight;
+		}
+		for (float& weight : weights) {
+			weight /= sum;
+		}
+		return weights;
+	}
+
+	// Each output pixel is one vector of four channels, accumulated over the taps. padded holds the line
+	// as floats with radius transparent pixels on both sides.
+#if defined(PF_SIMD_SSE2)
+	static std::size_t convolveSSE2(const float* padded, const float* weights, std::size_t taps, std::size_t count, uint8_t* output, std::ptrdiff_t step) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const float* window = padded + 4 * i;
+			__m128 sum = _mm_setzero_ps();
+			for (std::size_t k = 0; k < taps; ++k) {
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(window + 4 * k)));
+			}
+			__m128i rounded = _mm_cvtps_epi32(sum);
+			__m128i packed = _mm_packus_epi16(_mm_packs_epi32(rounded, rounded), _mm_setzero_si128());
+			uint32_t pixel = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+			std::copy_n(reinterpret_cast<const uint8_t*>(&pixel), 4, output + static_cast<std::ptrdiff_t>(i) * step);
+		}
+		return count;
+	}
+#elif defined(PF_SIMD_NEON)
+	static std::size_t convolveNEON(const float* padded, const float* weights, std::size_t taps, std::size_t count, uint8_t* output, std::ptrdiff_t step) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			const float* window = padded + 4 * i;
+			float32x4_t sum = vdupq_n_f32(0.f);
+			for (std::size_t k = 0; k < taps; ++k) {
+				sum = vmlaq_n_f32(sum, vld1q_f32(window + 4 * k), weights[k]);
+			}
+			uint16x4_t narrowed = vqmovun_s32(vcvtnq_s32_f32(sum));
+			uint8x8_t packed = vqmovn_u16(vcombine_u16(narrowed, narrowed));
+			uint8_t pixel[8];
+			vst1_u8(pixel, packed);
+			std::copy_n(pixel, 4, output + static_cast<std::ptrdiff_t>(i) * step);
+		}
+		return count;
+	}
+#endif
+
+	static void convolveLine(const BlurLine& line, const std::vector<float>& weights, std::vector<float>& padded) noexcept {
+		const std::size_t radius = weights.size() / 2;
+		padded.assign((line.length + 2 * radius) * 4, 0.f);
+		for (std::size_t i = 0; i < line.length; ++i) {
+			const uint8_t* pixel = line.source + static_cast<std::ptrdiff_t>(i) * line.step;
+			for (std::size_t c = 0; c < 4; ++c) {
+				padded[(radius + i) * 4 + c] = static_cast<float>(pixel[c]);
+			}
+		}
+
+		std::size_t i = 0;
+		switch (simdLevel()) {
+#if defined(PF_SIMD_SSE2)
+		case SimdLevel::AVX2:
+		case SimdLevel::SSE2:
+			i = convolveSSE2(padded.data(), weights.data(), weights.size(), line.length, line.destination, line.step);
+			break;
+#elif defined(PF_SIMD_NEON)
+		case SimdLevel::NEON:
+			i = convolveNEON(padded.data(), weights.data(), weights.size(), line.length, line.destination, line.step);
+			break;
+#endif
+		default:
+			break;
+		}
+
+		for (; i < line.length; ++i) {
+			const float* window = padded.data() + 4 * i;
+			uint8_t* pixel = line.destination + static_cast<std::ptrdiff_t>(i) * line.step;
+			for (std::size_t c = 0; c < 4; ++c) {
+				float sum = 0.f;
+				for (std::size_t k = 0; k < weights.size(); ++k) {
+					sum += weights[k] * window[4 * k + c];
+				}
+				pixel[c] = static_cast<uint8_t>(std::clamp(std::nearbyint(sum), 0.f, 255.f));
+			}
+		}
+	}
+
+	// A box covering [i - left, i + right] around every pixel.
+	struct Box {
+		int left, right;
+	};
+
+	// The three boxes of the SVG filter effects spec, whose combined variance is close to sigma squared.
+	// Even widths cannot be centered, so the first two lean in opposite directions and the third is one
+	// pixel wider.
+	static std::array<Box, 3> boxesFor(float sigma) noexcept {
+		int d = static_cast<int>(std::floor(sigma * 3.f * std::sqrt(2.f * 3.14159265f) / 4.f + 0.5f));
+		if (d % 2 == 1) {
+			Box centered{ d / 2, d / 2 };
+			return { centered, centered, centered };
+		}
+		return { Box{ d / 2, d / 2 - 1 }, Box{ d / 2 - 1, d / 2 }, Box{ d / 2, d / 2 } };
+	}
+
+	// Running sums over whole integers, so nothing drifts along long lines. Every pass rounds back to
+	// eight bits worth of precision, like the final image.
+	static void boxBlur(const uint32_t* input, uint32_t* output, std::size_t length, const Box& box) noexcept {
+		const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(length);
+		const uint32_t width = static_cast<uint32_t>(box.left + box.right + 1);
+
+		uint32_t sum[4] = { 0, 0, 0, 0 };
+		for (std::ptrdiff_t j = 0; j <= std::min<std::ptrdiff_t>(box.right, n - 1); ++j) {
+			for (std::size_t c = 0; c < 4; ++c) {
+				sum[c] += input[4 * j + c];
+			}
+		}
+
+		for (std::ptrdiff_t i = 0; i < n; ++i) {
+			for (std::size_t c = 0; c < 4; ++c) {
+				output[4 * i + c] = (sum[c] + width / 2) / width;
+			}
+
+			std::ptrdiff_t entering = i + box.right + 1, leaving = i - box.left;
+			for (std::size_t c = 0; c < 4; ++c) {
+				if (entering < n) {
+					sum[c] += input[4 * entering + c];
+				}
+				if (leaving >= 0) {
+					sum[c] -= input[4 * leaving + c];
+				}
+			}
+		}
+	}
+
+	static void boxBlurLine(const BlurLine& line, const std::array<Box, 3>& boxes, std::vector<uint32_t>& front, std::vector<uint32_t>& back) noexcept {
+		front.resize(line.length * 4);
+		back.resize(line.length * 4);
+		for (std::size_t i = 0; i < line.length; ++i) {
+			const uint8_t* pixel = line.source + static_cast<std::ptrdiff_t>(i) * line.step;
+			std::copy_n(pixel, 4, front.data() + 4 * i);
+		}
+
+		for (const Box& box : boxes) {
+			boxBlur(front.data(), back.data(), line.length, box);
+			std::swap(front, back);
+		}
+
+		for (std::size_t i = 0; i < line.length; ++i) {
+			uint8_t* pixel = line.destination + static_cast<std::ptrdiff_t>(i) * line.step;
+			std::copy_n(front.data() + 4 * i, 4, pixel);
+		}
+	}
+
+	void blur(const PatternFilter::BlurData& filter, const uint8_t* source, uint8_t* destination, const glm::ivec2& size, const Executor& executor) {
+		const std::size_t width = static_cast<std::size_t>(std::max(size.x, 0));
+		const std::size_t height = static_cast<std::size_t>(std::max(size.y, 0));
+		const std::size_t stride = width * 4;
+
+		const bool horizontal = filter.direction == BlurDirection::x;
+		const std::size_t lineCount = horizontal ? height : width;
+		const std::size_t lineLength = horizontal ? width : height;
+		auto lineAt = [&](std::size_t index) {
+			std::size_t offset = horizontal ? index * stride : index * 4;
+			return BlurLine{ source + offset, destination + offset, horizontal ? 4 : static_cast<std::ptrdiff_t>(stride), lineLength };
+		};
+
+		if (!(filter.sigma > 0.f)) {
+			if (source != destination) {
+				std::copy_n(source, stride * height, destination);
+			}
+			return;
+		}
+
+		const std::size_t taskCount = (lineCount + LinesPerTask - 1) / LinesPerTask;
+		if (filter.sigma <= DirectBlurMaxSigma) {
+			const std::vector<float> weights = gaussianWeights(filter.sigma);
+			executor.forEach(taskCount, [&](std::size_t task) {
+				std::vector<float> padded;
+				for (std::size_t index = task * LinesPerTask; index < std::min(lineCount, (task + 1) * LinesPerTask); ++index) {
+					convolveLine(lineAt(index), weights, padded);
+				}
+			});
+			return;
+		}
+
+		const std::array<Box, 3> boxes = boxesFor(filter.sigma);
+		executor.forEach(taskCount, [&](std::size_t task) {
+			std::vector<uint32_t> front, back;
+			for (std::size_t index = task * LinesPerTask; index < std::min(lineCount, (task + 1) * LinesPerTask); ++index) {
+				boxBlurLine(lineAt(index), boxes, front, back);
+			}
+		});
+	}
+
+	void blur(float sigma, const uint8_t* source, uint8_t* destination, const glm::ivec2& size, const Executor& executor) {
+		blur(PatternFilter::BlurData{ BlurDirection::x, sigma }, source, destination, size, executor);
+		blur(PatternFilter::BlurData{ BlurDirection::y, sigma }, destination, destination, size, executor);
+	}
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+#include <cinttypes>
+
+#include "../content/Effects.hpp"
+
+#include "Executor.hpp"
+
+#include <glm/vec2.hpp>
+
+namespace pf {
+	// Up to this sigma the Gaussian is convolved directly. Wider blurs use three box blurs, which cost
+	// the same whatever the sigma.
+	static constexpr float DirectBlurMaxSigma = 2.f;
+
+	// One separable pass of a Gaussian blur over tightly packed, premultiplied RGBA8 pixels, along the
+	// direction of the filter. Pixels outside the image count as transparent, so content that should
+	// spread past its bounds, like a drop shadow, needs 3 * sigma of padding. Lines are spread over the
+	// executor. source and destination may be the same image.
+	void blur(const PatternFilter::BlurData& filter, const uint8_t* source, uint8_t* destination, const glm::ivec2& size, const Executor& executor);
+
+	// Both passes, horizontal then vertical.
+	void blur(float sigma, const uint8_t* source, uint8_t* destination, const glm::ivec2& size, const Executor& executor);
+};
\ No newline at end of file
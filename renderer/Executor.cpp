@@ -0,0 +1,186 @@
+#include "Executor.hpp"
+
+#include <algorithm>
+
+namespace pf {
+	// The pool whose tasks this thread is running, if any.
+	static thread_local const ThreadPoolExecutor* currentPool = nullptr;
+
+	void SequentialExecutor::forEach(std::size_t length, const std::function<void(std::size_t)>& task) const {
+		for (std::size_t i = 0; i < length; ++i) {
+			task(i);
+		}
+	}
+
+	ThreadPoolExecutor::ThreadPoolExecutor()
+		: ThreadPoolExecutor(std::max(1u, std::thread::hardware_concurrency()))
+	{}
+	ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threadCount)
+		: currentTask(nullptr)
+		, generation(0)
+		, activeWorkers(0)
+		, failed(false)
+		, stopping(false)
+	{
+		// The calling thread counts as one of the threads.
+		std::size_t workerCount = threadCount > 0 ? threadCount - 1 : 0;
+		for (std::size_t i = 0; i <= workerCount; ++i) {
+			queues.push_back(std::make_unique<WorkQueue>());
+		}
+		workers.reserve(workerCount);
+		for (std::size_t i = 0; i < workerCount; ++i) {
+			workers.emplace_back(&ThreadPoolExecutor::workerMain, this, i);
+		}
+	}
+	ThreadPoolExecutor::~ThreadPoolExecutor() {
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			stopping = true;
+		}
+		startCondition.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	std::size_t ThreadPoolExecutor::threadCount() const noexcept {
+		return queues.size();
+	}
+
+	void ThreadPoolExecutor::forEach(std::size_t length, const std::function<void(std::size_t)>& task) const {
+		if (length == 0) {
+			return;
+		}
+		// Nested calls would wait on themselves, the thread is already one of the pool's.
+		if (workers.empty() || length == 1 || currentPool == this) {
+			for (std::size_t i = 0; i < length; ++i) {
+				task(i);
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> submitLock(submitMutex);
+
+		// Several chunks per thread, so that there is something left to steal when costs are uneven.
+		std::size_t chunkCount = std::min(length, queues.size() * 8);
+		std::size_t chunkSize = (length + chunkCount - 1) / chunkCount;
+		std::size_t queueIndex = 0;
+		for (std::size_t first = 0; first < length; first += chunkSize) {
+			WorkQueue& queue = *queues[queueIndex];
+			{
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.ranges.push_back(Range{ first, std::min(length, first + chunkSize) });
+			}
+			queueIndex = (queueIndex + 1) % queues.size();
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			currentTask = &task;
+			failure = nullptr;
+			failed = false;
+			activeWorkers = workers.size();
+			++generation;
+		}
+		startCondition.notify_all();
+
+		// The workers use task until they are done, so wait for them however this thread leaves.
+		struct WaitForWorkers {
+			const ThreadPoolExecutor& pool;
+
+			~WaitForWorkers() {
+				std::unique_lock<std::mutex> lock(pool.stateMutex);
+				pool.doneCondition.wait(lock, [this] { return pool.activeWorkers == 0; });
+				pool.currentTask = nullptr;
+			}
+		};
+
+		std::exception_ptr error;
+		{
+			WaitForWorkers wait{ *this };
+			runTasks(queues.size() - 1);
+		}
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			std::swap(error, failure);
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	void ThreadPoolExecutor::workerMain(std::size_t worker) {
+		uint64_t seenGeneration = 0;
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(stateMutex);
+				startCondition.wait(lock, [&] { return stopping || generation != seenGeneration; });
+				if (stopping) {
+					return;
+				}
+				seenGeneration = generation;
+			}
+
+			runTasks(worker);
+
+			std::lock_guard<std::mutex> lock(stateMutex);
+			if (--activeWorkers == 0) {
+				doneCondition.notify_one();
+			}
+		}
+	}
+
+	void ThreadPoolExecutor::runTasks(std::size_t worker) const {
+		const std::function<void(std::size_t)>& task = *currentTask;
+		const ThreadPoolExecutor* outerPool = currentPool;
+		currentPool = this;
+
+		Range range;
+		while (popRange(worker, range)) {
+			// After a failure the queues are only drained.
+			if (failed) {
+				continue;
+			}
+
+			try {
+				for (std::size_t i = range.first; i < range.last; ++i) {
+					task(i);
+				}
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(stateMutex);
+				if (!failure) {
+					failure = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+
+		currentPool = outerPool;
+	}
+
+	bool ThreadPoolExecutor::popRange(std::size_t worker, Range& range) const {
+		// Take from the back of our own queue first...
+		{
+			WorkQueue& own = *queues[worker];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.ranges.empty()) {
+				range = own.ranges.back();
+				own.ranges.pop_back();
+				return true;
+			}
+		}
+
+		// ...then steal from the front of the others.
+		for (std::size_t i = 1; i < queues.size(); ++i) {
+			WorkQueue& victim = *queues[(worker + i) % queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.ranges.empty()) {
+				range = victim.ranges.front();
+				victim.ranges.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <atomic>
+#include <exception>
+
+namespace pf {
+	// An abstraction over threading and parallelism systems.
+	struct Executor {
+		virtual ~Executor() = default;
+
+		// Calls task(index) once for every index in [0, length), possibly in parallel.
+		// Returns once every call has finished.
+		virtual void forEach(std::size_t length, const std::function<void(std::size_t)>& task) const = 0;
+
+		// Equivalent to collecting builder(index) for every index in [0, length).
+		template<typename T, typename F>
+		std::vector<T> buildVector(std::size_t length, F&& builder) const {
+			std::vector<T> result(length);
+			forEach(length, [&](std::size_t index) {
+				result[index] = builder(index);
+			});
+			return result;
+		}
+	};
+
+	// An executor that simply executes tasks sequentially in the calling thread.
+	struct SequentialExecutor: public Executor {
+		void forEach(std::size_t length, const std::function<void(std::size_t)>& task) const override;
+	};
+
+	// An executor that spreads tasks over a fixed set of worker threads. Each worker owns a queue of
+	// index ranges and steals from the other queues once its own runs dry, so uneven task costs
+	// balance out without a shared queue. The calling thread takes part in the work.
+	//
+	// When a task throws, the remaining tasks are skipped and forEach rethrows the first exception once
+	// every worker has stopped. A forEach issued from a task of the same pool runs inline on that thread.
+	struct ThreadPoolExecutor: public Executor {
+		ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+		ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+		ThreadPoolExecutor();
+		ThreadPoolExecutor(std::size_t threadCount);
+		~ThreadPoolExecutor();
+
+		std::size_t threadCount() const noexcept;
+
+		void forEach(std::size_t length, const std::function<void(std::size_t)>& task) const override;
+	private:
+		struct Range {
+			std::size_t first, last;
+		};
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<Range> ranges;
+		};
+
+		void workerMain(std::size_t worker);
+		void runTasks(std::size_t worker) const;
+		bool popRange(std::size_t worker, Range& range) const;
+
+		std::vector<std::thread> workers;
+		// One queue per worker thread, plus one for the calling thread.
+		std::vector<std::unique_ptr<WorkQueue>> queues;
+
+		// Serializes concurrent forEach calls on the same pool.
+		mutable std::mutex submitMutex;
+
+		mutable std::mutex stateMutex;
+		mutable std::condition_variable startCondition, doneCondition;
+		mutable const std::function<void(std::size_t)>* currentTask;
+		mutable uint64_t generation;
+		mutable std::size_t activeWorkers;
+		// The first exception thrown by a task of the current forEach.
+		mutable std::exception_ptr failure;
+		mutable std::atomic<bool> failed;
+		bool stopping;
+	};
+};
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "Rasterizer.hpp"
+
+#include <array>
+#include <cassert>
+#include <algorithm>
+#include <iterator>
+
+namespace pf {
+	// Exact round(x / 255) for x in [0, 255 * 255].
+	static uint32_t div255(uint32_t x) noexcept {
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	static std::array<uint32_t, 4> premultiply(const ColorU& color) noexcept {
+		return {
+			div255(uint32_t(color.r) * color.a),
+			div255(uint32_t(color.g) * color.a),
+			div255(uint32_t(color.b) * color.a),
+			color.a,
+		};
+	}
+
+	static void blendR8(uint8_t* pixel, uint32_t alpha, uint32_t cover) noexcept {
+		alpha = div255(alpha * cover);
+		*pixel = static_cast<uint8_t>(alpha + div255(*pixel * (255 - alpha)));
+	}
+	// Source is the premultiplied color.
+	static void blendRGBA8(uint8_t* pixel, const uint32_t* source, uint32_t cover) noexcept {
+		uint32_t inverse = 255 - div255(source[3] * cover);
+		for (int c = 0; c < 4; ++c) {
+			pixel[c] = static_cast<uint8_t>(div255(source[c] * cover) + div255(pixel[c] * inverse));
+		}
+	}
+
+	SoftwareRasterizer::SoftwareRasterizer(const glm::ivec2& _size, TextureFormat _format, float _tolerance)
+		: size(glm::max(_size, glm::ivec2{ 0 }))
+		, format(_format)
+		, tolerance(_tolerance)
+		, data(TextureData::U8)
+	{
+		assert(format == TextureFormat::R8 || format == TextureFormat::RGBA8);
+		data.resize(static_cast<std::size_t>(size.x) * size.y * channels(format));
+	}
+
+	void SoftwareRasterizer::clear(const ColorU& color) {
+		std::vector<uint8_t>& pixels = data.asU8();
+		if (format == TextureFormat::R8) {
+			std::fill(pixels.begin(), pixels.end(), color.a);
+			return;
+		}
+
+		const std::array<uint32_t, 4> source = premultiply(color);
+		for (std::size_t i = 0; i < pixels.size(); i += 4) {
+			std::copy(source.begin(), source.end(), pixels.data() + i);
+		}
+	}
+
+	void SoftwareRasterizer::fill(const Outline& outline, const ColorU& color, const Transform2F& form, FillRule rule) {
+		if (outline.empty() || color.is_fully_transparent()) {
+			return;
+		}
+
+		// Segments are transformed as they are flattened, so the outline isn't copied. The corners of
+		// the bounds bound the transformed outline too, if loosely.
+		fillSource(outline, form.isIdentity() ? outline.bounds : form.apply(outline.bounds), form, color, rule);
+	}
+	void SoftwareRasterizer::fill(const OutlineView& outline, const ColorU& color, const Transform2F& form, FillRule rule) {
+		if (outline.empty() || color.is_fully_transparent()) {
+			return;
+		}
+
+		fillSource(outline, form.isIdentity() ? outline.bounds : form.apply(outline.bounds), form, color, rule);
+	}
+
+	template<typename Source>
+	void SoftwareRasterizer::fillSource(const Source& outline, const RectF& outlineBounds, const Transform2F& form, const ColorU& color, FillRule rule) {
+		// Only the pixels under the bounds need a coverage pass.
+		std::optional<RectF> bounds = outlineBounds.intersection(RectF::fromPoints(glm::vec2{ 0.f }, glm::vec2{ size }));
+		if (!bounds) {
+			return;
+		}
+		RectI area{ bounds->roundOut() };
+		if (area.isEmpty()) {
+			return;
+		}
+
+		if (static_cast<std::size_t>(area.width()) * area.height() > SparseAreaThreshold) {
+			sparseAccumulator.reset(area.width(), area.height());
+			accumulate(outline, form, area, sparseAccumulator);
+
+			spans.clear();
+			sparseAccumulator.resolve(rule, spans);
+			compositeSpans(area, color);
+			return;
+		}
+
+		accumulator.reset(area.width(), area.height());
+		accumulate(outline, form, area, accumulator);
+
+		mask.resize(static_cast<std::size_t>(area.width()) * area.height());
+		accumulator.resolve(rule, mask.data(), static_cast<std::size_t>(area.width()));
+		composite(area, color);
+	}
+
+	template<typename Source, typename Accumulator>
+	void SoftwareRasterizer::accumulate(const Source& outline, const Transform2F& form, const RectI& area, Accumulator& target) {
+		const glm::vec4 origin{ glm::vec2{ area.origin() }, glm::vec2{ area.origin() } };
+		const bool transform = !form.isIdentity();
+
+		for (const auto& contour : outline) {
+			ContourIter iter = contour.iter();
+			while (!iter.done()) {
+				Segment segment = transform ? iter.next().transform(form) : iter.next();
+				if (segment.isLine()) {
+					target.addLine(LineSegment2F{ glm::vec4{ LineSegment2F{ segment.front(), segment.back() } } - origin });
+					continue;
+				}
+
+				lines.clear();
+				segment.flatten(tolerance, std::back_inserter(lines));
+				for (const LineSegment2F& line : lines) {
+					target.addLine(LineSegment2F{ glm::vec4{ line } - origin });
+				}
+			}
+		}
+	}
+
+	void SoftwareRasterizer::composite(const RectI& area, const ColorU& color) {
+		std::vector<uint8_t>& pixels = data.asU8();
+		const std::size_t width = static_cast<std::size_t>(area.width());
+		const uint8_t* coverage = mask.data();
+
+		if (format == TextureFormat::R8) {
+			for (int y = area.minY(); y < area.maxY(); ++y, coverage += width) {
+				uint8_t* row = pixels.data() + static_cast<std::size_t>(y) * size.x + area.minX();
+				for (std::size_t x = 0; x < width; ++x) {
+					blendR8(row + x, color.a, coverage[x]);
+				}
+			}
+			return;
+		}
+
+		const std::array<uint32_t, 4> source = premultiply(color);
+		for (int y = area.minY(); y < area.maxY(); ++y, coverage += width) {
+			uint8_t* row = pixels.data() + (static_cast<std::size_t>(y) * size.x + area.minX()) * 4;
+			for (std::size_t x = 0; x < width; ++x, row += 4) {
+				if (coverage[x] != 0) {
+					blendRGBA8(row, source.data(), coverage[x]);
+				}
+			}
+		}
+	}
+
+	void SoftwareRasterizer::compositeSpans(const RectI& area, const ColorU& color) {
+		std::vector<uint8_t>& pixels = data.asU8();
+		const std::array<uint32_t, 4> source = premultiply(color);
+
+		for (const CoverageSpan& span : spans) {
+			std::size_t first = static_cast<std::size_t>(area.minY() + span.y) * size.x + area.minX() + span.x;
+			if (format == TextureFormat::R8) {
+				uint8_t* pixel = pixels.data() + first;
+				for (int32_t i = 0; i < span.length; ++i) {
+					blendR8(pixel + i, color.a, span.coverage);
+				}
+			}
+			else {
+				uint8_t* pixel = pixels.data() + first * 4;
+				for (int32_t i = 0; i < span.length; ++i, pixel += 4) {
+					blendRGBA8(pixel, source.data(), span.coverage);
+				}
+			}
+		}
+	}
+};
\ No newline at end of file
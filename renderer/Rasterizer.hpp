@@ -0,0 +1,59 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "../geometry/LineSegment.hpp"
+#include "../geometry/Rect.hpp"
+#include "../geometry/Transform2d.hpp"
+#include "../color/color.hpp"
+#include "../content/Outline.hpp"
+#include "../content/OutlineArena.hpp"
+#include "../content/Fill.hpp"
+#include "../gpu/Enums.hpp"
+#include "../gpu/TextureData.hpp"
+
+#include "Tiler.hpp"
+
+namespace pf {
+	// Renders outlines on the CPU, for headless use where there is no GPU device.
+	// Coverage is the exact area coverage from CoverageAccumulator and compositing is done in integers,
+	// so a given sequence of fills produces the same bytes on every run and every SIMD level.
+	struct SoftwareRasterizer {
+		// Fills whose clipped bounds cover more pixels than this accumulate coverage sparsely, see
+		// SparseCoverageAccumulator. Big outlines with little edge length then skip the dense pass.
+		static constexpr std::size_t SparseAreaThreshold = std::size_t(1) << 20;
+
+		// Format must be R8 or RGBA8. RGBA8 pixels are stored premultiplied, R8 only keeps the alpha.
+		SoftwareRasterizer(const glm::ivec2& _size, TextureFormat _format = TextureFormat::RGBA8, float _tolerance = FlatteningTolerance);
+
+		void clear(const ColorU& color = ColorU::transparent_black());
+
+		// Composites the outline, transformed by form, over the current contents. Segments are
+		// transformed as they are flattened, so the outline is never copied.
+		void fill(const Outline& outline, const ColorU& color, const Transform2F& form = Transform2F{}, FillRule rule = FillRule::Winding);
+		// Same for an outline in an arena, read where it lies.
+		void fill(const OutlineView& outline, const ColorU& color, const Transform2F& form = Transform2F{}, FillRule rule = FillRule::Winding);
+
+		glm::ivec2 size;
+		TextureFormat format;
+		float tolerance;
+		// Rows of size.x pixels, top to bottom, tightly packed.
+		TextureData data;
+	private:
+		template<typename Source>
+		void fillSource(const Source& outline, const RectF& outlineBounds, const Transform2F& form, const ColorU& color, FillRule rule);
+		template<typename Source, typename Accumulator>
+		void accumulate(const Source& outline, const Transform2F& form, const RectI& area, Accumulator& target);
+		void composite(const RectI& area, const ColorU& color);
+		void compositeSpans(const RectI& area, const ColorU& color);
+
+		// Scratch space, reused across fills.
+		CoverageAccumulator accumulator;
+		SparseCoverageAccumulator sparseAccumulator;
+		std::vector<uint8_t> mask;
+		std::vector<CoverageSpan> spans;
+		std::vector<LineSegment2F> lines;
+	};
+};
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "SceneBuilder.hpp"
+
+#include <cassert>
+
+namespace pf {
+	struct TiledPath {
+		BuiltPath path;
+		std::vector<Fill> fills;
+	};
+
+	// Empties the tiles of the path at depth that the z-buffer hides, then renumbers the remaining
+	// alpha tiles and drops the fills of the hidden ones. Returns the number of alpha tiles dropped.
+	static uint32_t cullOccludedTiles(TiledPath& entry, const ZBuffer& zbuffer, uint32_t depth) {
+		BuiltPath& path = entry.path;
+
+		// Maps the alpha tile ids to InvalidAlphaTileId for the hidden tiles, allocated on the first one.
+		std::vector<uint32_t> remap;
+		for (std::size_t i = 0; i < path.tiles.size(); ++i) {
+			TileKind& kind = path.kinds.data[i];
+			if (kind == TileKind::Empty || zbuffer.test(path.tiles.indexToCoords(i), depth)) {
+				continue;
+			}
+
+			TileObjectPrimitive& tile = path.tiles.data[i];
+			if (kind == TileKind::Alpha) {
+				if (remap.empty()) {
+					remap.resize(path.alphaTileCount, 0);
+				}
+				remap[tile.alphaTileId] = InvalidAlphaTileId;
+				tile.alphaTileId = InvalidAlphaTileId;
+			}
+			kind = TileKind::Empty;
+			tile.backdrop = 0;
+		}
+
+		if (remap.empty()) {
+			return 0;
+		}
+
+		// The survivors keep their allocation order.
+		uint32_t alphaTileCount = 0;
+		for (uint32_t& id : remap) {
+			if (id != InvalidAlphaTileId) {
+				id = alphaTileCount++;
+			}
+		}
+		for (TileObjectPrimitive& tile : path.tiles) {
+			if (!tile.isSolid()) {
+				tile.alphaTileId = remap[tile.alphaTileId];
+			}
+		}
+
+		uint32_t culled = path.alphaTileCount - alphaTileCount;
+		std::size_t kept = 0;
+		for (const Fill& fill : entry.fills) {
+			uint32_t link = remap[fill.link];
+			if (link != InvalidAlphaTileId) {
+				entry.fills[kept++] = Fill{ fill.lineSegment, link };
+			}
+		}
+		entry.fills.resize(kept);
+		path.alphaTileCount = alphaTileCount;
+		return culled;
+	}
+
+	SceneBuilder::SceneBuilder(const RectF& _viewBox, float _tolerance)
+		: viewBox(_viewBox)
+		, tolerance(_tolerance)
+		, alphaTileCount(0)
+		, culledAlphaTileCount(0)
+	{}
+
+	void SceneBuilder::clear() {
+		paths.clear();
+		fills.clear();
+		alphaTileCount = 0;
+		culledAlphaTileCount = 0;
+	}
+
+	void SceneBuilder::build(const std::vector<Outline>& outlines, const Executor& executor) {
+		build(outlines.data(), outlines.size(), executor);
+	}
+	void SceneBuilder::build(const std::vector<Outline>& outlines, const std::vector<PathStyle>& styles, const Executor& executor) {
+		assert(styles.size() == outlines.size());
+		build(outlines.data(), outlines.size(), executor, styles.data());
+	}
+
+	void SceneBuilder::build(const Outline* outlines, std::size_t count, const Executor& executor, const PathStyle* styles) {
+		buildPaths(count, executor, styles, [outlines](std::size_t index) -> const Outline& {
+			return outlines[index];
+		});
+	}
+	void SceneBuilder::build(const OutlineArena& arena, const Executor& executor, const PathStyle* styles) {
+		buildPaths(arena.size(), executor, styles, [&arena](std::size_t index) {
+			return arena[index];
+		});
+	}
+
+	template<typename OutlineAt>
+	void SceneBuilder::buildPaths(std::size_t count, const Executor& executor, const PathStyle* styles, OutlineAt&& outlineAt) {
+		clear();
+
+		std::vector<TiledPath> tiled = executor.buildVector<TiledPath>(count, [&](std::size_t index) {
+			FillRule fillRule = styles ? styles[index].fillRule : FillRule::Winding;
+			Tiler tiler{ outlineAt(index), viewBox, fillRule, tolerance };
+			tiler.generateTiles();
+
+			TiledPath result;
+			result.path.tileBounds = tiler.tileBounds;
+			result.path.fillRule = tiler.fillRule;
+			result.path.tiles = std::move(tiler.tiles);
+			result.path.kinds = std::move(tiler.kinds);
+			result.path.backdrops = std::move(tiler.backdrops);
+			result.path.alphaTileCount = tiler.alphaTileCount;
+			result.fills = std::move(tiler.fills);
+			return result;
+		});
+
+		// Record the occluders, then cull every path against the ones in front of it.
+		bool anyOccluders = false;
+		for (std::size_t index = 0; styles && index < count; ++index) {
+			anyOccluders = anyOccluders || styles[index].occludes();
+		}
+		if (anyOccluders) {
+			ZBuffer zbuffer{ viewBox };
+			for (std::size_t index = 0; index < count; ++index) {
+				if (styles[index].occludes()) {
+					zbuffer.update(tiled[index].path.kinds, static_cast<uint32_t>(index));
+				}
+			}
+
+			std::vector<uint32_t> culled = executor.buildVector<uint32_t>(count, [&](std::size_t index) {
+				return cullOccludedTiles(tiled[index], zbuffer, static_cast<uint32_t>(index));
+			});
+			for (uint32_t value : culled) {
+				culledAlphaTileCount += value;
+			}
+		}
+
+		// Assign every path its slice of the alpha tiles and fills.
+		std::size_t fillCount = 0;
+		for (TiledPath& entry : tiled) {
+			entry.path.firstAlphaTileId = alphaTileCount;
+			entry.path.firstFill = fillCount;
+			entry.path.fillCount = entry.fills.size();
+
+			alphaTileCount += entry.path.alphaTileCount;
+			fillCount += entry.fills.size();
+		}
+
+		// The slices are disjoint, so the paths can be merged in parallel.
+		fills.resize(fillCount);
+		paths.resize(count);
+		executor.forEach(count, [&](std::size_t index) {
+			TiledPath& entry = tiled[index];
+			uint32_t base = entry.path.firstAlphaTileId;
+
+			Fill* output = fills.data() + entry.path.firstFill;
+			for (const Fill& fill : entry.fills) {
+				*output++ = Fill{ fill.lineSegment, fill.link + base };
+			}
+
+			for (TileObjectPrimitive& tile : entry.path.tiles) {
+				if (!tile.isSolid()) {
+					tile.alphaTileId += base;
+				}
+			}
+
+			paths[index] = std::move(entry.path);
+		});
+	}
+};
\ No newline at end of file
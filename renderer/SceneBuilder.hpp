@@ -0,0 +1,74 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include "../geometry/Rect.hpp"
+#include "../content/Outline.hpp"
+#include "../content/Effects.hpp"
+
+#include "Executor.hpp"
+#include "Tiles.hpp"
+#include "Tiler.hpp"
+#include "ZBuffer.hpp"
+
+namespace pf {
+	// What the builder needs to know about how a path gets drawn.
+	struct PathStyle {
+		FillRule fillRule = FillRule::Winding;
+		BlendMode blendMode = BlendMode::SrcOver;
+		// Set when the paint has no transparent pixels.
+		bool opaque = false;
+
+		// Whether the solid tiles of the path hide everything below them.
+		bool occludes() const noexcept {
+			return opaque && occludesBackdrop(blendMode);
+		}
+	};
+
+	struct BuiltPath {
+		RectI tileBounds;
+		// One tile per entry of tileBounds. Alpha tile ids are scene wide.
+		DenseTileMap<TileObjectPrimitive> tiles;
+		// Solid tiles need no mask, and empty ones need not be drawn at all. Tiles hidden behind
+		// opaque paths are empty.
+		DenseTileMap<TileKind> kinds;
+		// The sum of the backdrops of each tile column above the view box.
+		std::vector<int32_t> backdrops;
+		// Applies to the backdrops and to the coverage accumulated from the fills.
+		FillRule fillRule;
+
+		uint32_t firstAlphaTileId, alphaTileCount;
+		// The range of this path's fills in SceneBuilder::fills.
+		std::size_t firstFill, fillCount;
+	};
+
+	// Tiles every outline of a scene independently, then merges the per path results. Alpha tile ids
+	// are allocated per path and rebased with a prefix sum, so no state is shared while tiling.
+	//
+	// Outlines are given back to front. Tiles covered by the solid tiles of an occluding path in front
+	// of them are dropped along with their fills.
+	struct SceneBuilder {
+		SceneBuilder(const RectF& _viewBox, float _tolerance = FlatteningTolerance);
+
+		// When given, styles holds one style per outline, otherwise every outline gets the default style.
+		void build(const Outline* outlines, std::size_t count, const Executor& executor, const PathStyle* styles = nullptr);
+		void build(const std::vector<Outline>& outlines, const Executor& executor);
+		void build(const std::vector<Outline>& outlines, const std::vector<PathStyle>& styles, const Executor& executor);
+		// Tiles the outlines of the arena where they lie, in arena order.
+		void build(const OutlineArena& arena, const Executor& executor, const PathStyle* styles = nullptr);
+
+		void clear();
+
+		RectF viewBox;
+		float tolerance;
+
+		std::vector<BuiltPath> paths;
+		std::vector<Fill> fills;
+		uint32_t alphaTileCount;
+		// Alpha tiles dropped by occlusion culling in the last build.
+		uint32_t culledAlphaTileCount;
+	private:
+		template<typename OutlineAt>
+		void buildPaths(std::size_t count, const Executor& executor, const PathStyle* styles, OutlineAt&& outlineAt);
+	};
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+#include <cinttypes>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include <optional>
+
+#include <glm/vec2.hpp>
+#include "../geometry/Rect.hpp"
+
+namespace pf {
+	// One value per tile of rect, stored row major.
+	template<typename T>
+	struct DenseTileMap {
+		using container_t = std::vector<T>;
+
+		using iterator = typename container_t::iterator;
+		using const_iterator = typename container_t::const_iterator;
+
+		// Fills the map with build(coords), visiting the tiles in storage order.
+		template<typename F>
+		static DenseTileMap fromBuilder(F&& build, const RectI& rect) {
+			DenseTileMap map;
+			map.rect = rect;
+			map.data.reserve(map.area());
+			for (int y = rect.minY(); y < rect.maxY(); ++y) {
+				for (int x = rect.minX(); x < rect.maxX(); ++x) {
+					map.data.push_back(build(glm::ivec2{ x, y }));
+				}
+			}
+			return map;
+		}
+
+		DenseTileMap()
+			: rect{}
+		{}
+		DenseTileMap(const RectI& _rect, const T& value = T{})
+			: rect(_rect)
+			, data(area(), value)
+		{}
+
+		std::size_t size() const noexcept {
+			return data.size();
+		}
+		bool empty() const noexcept {
+			return data.empty();
+		}
+
+		std::optional<std::size_t> coordsToIndex(const glm::ivec2& coords) const noexcept {
+			if (!rect.contains(coords)) {
+				return std::nullopt;
+			}
+			return coordsToIndexUnchecked(coords);
+		}
+		std::size_t coordsToIndexUnchecked(const glm::ivec2& coords) const noexcept {
+			return static_cast<std::size_t>(coords.y - rect.minY()) * static_cast<std::size_t>(rect.width())
+				+ static_cast<std::size_t>(coords.x - rect.minX());
+		}
+		glm::ivec2 indexToCoords(std::size_t index) const noexcept {
+			std::size_t width = static_cast<std::size_t>(rect.width());
+			return rect.origin() + glm::ivec2{ static_cast<int>(index % width), static_cast<int>(index / width) };
+		}
+
+		// Null outside of rect.
+		T* get(const glm::ivec2& coords) noexcept {
+			return rect.contains(coords) ? &data[coordsToIndexUnchecked(coords)] : nullptr;
+		}
+		const T* get(const glm::ivec2& coords) const noexcept {
+			return rect.contains(coords) ? &data[coordsToIndexUnchecked(coords)] : nullptr;
+		}
+
+		T& operator[](const glm::ivec2& coords) noexcept {
+			assert(rect.contains(coords));
+			return data[coordsToIndexUnchecked(coords)];
+		}
+		const T& operator[](const glm::ivec2& coords) const noexcept {
+			assert(rect.contains(coords));
+			return data[coordsToIndexUnchecked(coords)];
+		}
+
+		// The rect.width() tiles of row y, in tile coordinates.
+		T* row(int y) noexcept {
+			assert(y >= rect.minY() && y < rect.maxY());
+			return data.data() + static_cast<std::size_t>(y - rect.minY()) * static_cast<std::size_t>(rect.width());
+		}
+		const T* row(int y) const noexcept {
+			assert(y >= rect.minY() && y < rect.maxY());
+			return data.data() + static_cast<std::size_t>(y - rect.minY()) * static_cast<std::size_t>(rect.width());
+		}
+
+		iterator begin() noexcept {
+			return data.begin();
+		}
+		iterator end() noexcept {
+			return data.end();
+		}
+		const_iterator begin() const noexcept {
+			return data.begin();
+		}
+		const_iterator end() const noexcept {
+			return data.end();
+		}
+
+		RectI rect;
+		container_t data;
+	private:
+		std::size_t area() const noexcept {
+			return static_cast<std::size_t>(std::max(rect.width(), 0)) * static_cast<std::size_t>(std::max(rect.height(), 0));
+		}
+	};
+};
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "Tiler.hpp"
+#include "../content/Clip.hpp"
+
+#include <glm/common.hpp>
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+namespace pf {
+	enum class StepDirection {
+		None,
+		X,
+		Y,
+	};
+
+	static RectI tileBoundsOf(const RectF& outlineBounds, const RectF& viewBox) {
+		std::optional<RectF> bounds = outlineBounds.intersection(viewBox);
+		return roundRectOutToTileBounds(bounds.value_or(RectF{}));
+	}
+
+	Tiler::Tiler(const Outline& _outline, const RectF& _viewBox, FillRule _fillRule, float _tolerance)
+		: Tiler(&_outline, OutlineView{ nullptr, 0, 0, RectF{} }, _outline.bounds, _viewBox, _fillRule, _tolerance)
+	{}
+	Tiler::Tiler(const OutlineView& _outline, const RectF& _viewBox, FillRule _fillRule, float _tolerance)
+		: Tiler(nullptr, _outline, _outline.bounds, _viewBox, _fillRule, _tolerance)
+	{}
+	Tiler::Tiler(const Outline* _outline, const OutlineView& _view, const RectF& bounds, const RectF& _viewBox, FillRule _fillRule, float _tolerance)
+		: outline(_outline)
+		, view(_view)
+		, viewBox(_viewBox)
+		, tileBounds(tileBoundsOf(bounds, _viewBox))
+		, fillRule(_fillRule)
+		, tolerance(_tolerance)
+		, alphaTileCount(0)
+	{
+		backdrops.resize(tileBounds.width(), 0);
+		tiles = DenseTileMap<TileObjectPrimitive>::fromBuilder([](const glm::ivec2& coords) {
+			return TileObjectPrimitive{
+				static_cast<int16_t>(coords.x),
+				static_cast<int16_t>(coords.y),
+				InvalidAlphaTileId,
+				0
+			};
+		}, tileBounds);
+		tileBackdrops = DenseTileMap<int8_t>{ tileBounds, 0 };
+		kinds = DenseTileMap<TileKind>{ tileBounds, TileKind::Empty };
+	}
+
+	void Tiler::generateTiles() {
+		if (outline) {
+			generateFills(*outline);
+		}
+		else {
+			generateFills(view);
+		}
+		prepareTiles();
+	}
+
+	template<typename Source>
+	void Tiler::generateFills(const Source& source) {
+		for (const auto& contour : source) {
+			ContourIter iter = contour.iter();
+			while (!iter.done()) {
+				processSegment(iter.next());
+			}
+		}
+	}
+
+	void Tiler::prepareTiles() {
+		propagateBackdrops(tileBackdrops, backdrops, fillRule, kinds);
+		for (std::size_t i = 0; i < tiles.size(); ++i) {
+			tiles.data[i].backdrop = tileBackdrops.data[i];
+		}
+	}
+
+	void Tiler::processSegment(const Segment& segment) {
+		if (segment.isLine()) {
+			processLineSegment(LineSegment2F{ segment.front(), segment.back() });
+			return;
+		}
+
+		lines.clear();
+		segment.flatten(tolerance, std::back_inserter(lines));
+		for (const LineSegment2F& line : lines) {
+			processLineSegment(line);
+		}
+	}
+
+	// The algorithm to step through tiles is Amanatides and Woo, "A Fast Voxel Traversal Algorithm
+	// for Ray Tracing" 1987.
+	void Tiler::processLineSegment(const LineSegment2F& segment) {
+		RectF clipBox = RectF::fromPoints(
+			glm::vec2{ viewBox.minX(), -std::numeric_limits<float>::infinity() },
+			viewBox.lowerRight());
+		std::optional<LineSegment2F> clipped = clipLineSegmentToRect(segment, clipBox);
+		if (!clipped) {
+			return;
+		}
+
+		const LineSegment2F& line = *clipped;
+		glm::vec2 tileSize{ static_cast<float>(TileWidth), static_cast<float>(TileHeight) };
+
+		glm::ivec2 fromTileCoords{ glm::floor(line.from() / tileSize) };
+		glm::ivec2 toTileCoords{ glm::floor(line.to() / tileSize) };
+
+		glm::vec2 vector = line.vector();
+		glm::ivec2 step{ vector.x < 0.f ? -1 : 1, vector.y < 0.f ? -1 : 1 };
+
+		glm::ivec2 firstTileCrossing = fromTileCoords + glm::ivec2{ vector.x < 0.f ? 0 : 1, vector.y < 0.f ? 0 : 1 };
+		glm::vec2 tMax = (glm::vec2{ firstTileCrossing } * tileSize - line.from()) / vector;
+		glm::vec2 tDelta = glm::abs(tileSize / vector);
+
+		glm::vec2 currentPosition = line.from();
+		glm::ivec2 tileCoords = fromTileCoords;
+		StepDirection lastStepDirection = StepDirection::None;
+
+		while (true) {
+			StepDirection nextStepDirection;
+			if (tMax.x < tMax.y) {
+				nextStepDirection = StepDirection::X;
+			}
+			else if (tMax.x > tMax.y) {
+				nextStepDirection = StepDirection::Y;
+			}
+			else {
+				// This should only happen if the line's destination is precisely on a corner point
+				// between tiles. In that case we just need to step in the positive direction to move
+				// to the lower right tile.
+				nextStepDirection = step.x > 0 ? StepDirection::X : StepDirection::Y;
+			}
+
+			float nextT = std::min(1.f, nextStepDirection == StepDirection::X ? tMax.x : tMax.y);
+
+			// If we've reached the end tile, don't step at all.
+			if (tileCoords == toTileCoords) {
+				nextStepDirection = StepDirection::None;
+			}
+
+			glm::vec2 nextPosition = line.sample(nextT);
+			LineSegment2F clippedSegment{ currentPosition, nextPosition };
+			addFill(clippedSegment, tileCoords);
+
+			// Add extra fills if necessary.
+			glm::vec2 tileUpperLeft = glm::vec2{ tileCoords } * tileSize;
+			if (step.y < 0 && nextStepDirection == StepDirection::Y) {
+				// Leaves through top boundary.
+				addFill(LineSegment2F{ clippedSegment.to(), tileUpperLeft }, tileCoords);
+			}
+			else if (step.y > 0 && lastStepDirection == StepDirection::Y) {
+				// Enters through top boundary.
+				addFill(LineSegment2F{ tileUpperLeft, clippedSegment.from() }, tileCoords);
+			}
+
+			// Adjust backdrop if necessary.
+			if (step.x < 0 && lastStepDirection == StepDirection::X) {
+				// Entered through right boundary.
+				adjustAlphaTileBackdrop(tileCoords, 1);
+			}
+			else if (step.x > 0 && nextStepDirection == StepDirection::X) {
+				// Leaving through right boundary.
+				adjustAlphaTileBackdrop(tileCoords, -1);
+			}
+
+			// Take a step.
+			switch (nextStepDirection) {
+			case StepDirection::None:
+				return;
+			case StepDirection::X:
+				tMax.x += tDelta.x;
+				tileCoords.x += step.x;
+				break;
+			case StepDirection::Y:
+				tMax.y += tDelta.y;
+				tileCoords.y += step.y;
+				break;
+			}
+
+			currentPosition = nextPosition;
+			lastStepDirection = nextStepDirection;
+		}
+	}
+
+	void Tiler::addFill(const LineSegment2F& segment, const glm::ivec2& tileCoords) {
+		// Ensure this fill is in bounds. If not, cull it.
+		if (!tileBounds.contains(tileCoords)) {
+			return;
+		}
+
+		static_assert(TileWidth == TileHeight, "Fills assume square tiles");
+
+		// Convert to 8.8 fixed point, relative to the upper left corner of the tile.
+		glm::vec2 tileUpperLeft = glm::vec2{ tileCoords } * static_cast<float>(TileWidth);
+		glm::vec4 local = (static_cast<const glm::vec4&>(segment) - glm::vec4{ tileUpperLeft, tileUpperLeft }) * 256.f;
+		// Rounded to nearest like to_i32x4, truncating would pull every fill towards the tile origin.
+		glm::ivec4 fixed{ glm::round(glm::clamp(local, glm::vec4{ 0.f }, glm::vec4{ static_cast<float>(TileWidth * 256 - 1) })) };
+
+		// Cull degenerate fills.
+		if (fixed.x == fixed.z) {
+			return;
+		}
+
+		uint32_t alphaTileId = getOrAllocateAlphaTile(tileCoords);
+		fills.push_back(Fill{
+			LineSegmentU16{
+				static_cast<uint16_t>(fixed.x),
+				static_cast<uint16_t>(fixed.y),
+				static_cast<uint16_t>(fixed.z),
+				static_cast<uint16_t>(fixed.w)
+			},
+			alphaTileId
+		});
+	}
+
+	void Tiler::adjustAlphaTileBackdrop(const glm::ivec2& tileCoords, int8_t delta) {
+		glm::ivec2 offset = tileCoords - tileBounds.origin();
+		if (offset.x < 0 || offset.x >= tileBounds.width() || offset.y >= tileBounds.height()) {
+			return;
+		}
+
+		if (offset.y < 0) {
+			backdrops[offset.x] += delta;
+			return;
+		}
+
+		tileBackdrops[tileCoords] += delta;
+	}
+
+	uint32_t Tiler::getOrAllocateAlphaTile(const glm::ivec2& tileCoords) {
+		TileObjectPrimitive& tile = tiles[tileCoords];
+		if (tile.alphaTileId == InvalidAlphaTileId) {
+			tile.alphaTileId = alphaTileCount++;
+			kinds[tileCoords] = TileKind::Alpha;
+		}
+		return tile.alphaTileId;
+	}
+};
\ No newline at end of file
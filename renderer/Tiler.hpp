@@ -0,0 +1,66 @@
+#pragma once
+#include <cinttypes>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "../geometry/LineSegment.hpp"
+#include "../geometry/Rect.hpp"
+#include "../content/Outline.hpp"
+#include "../content/OutlineArena.hpp"
+#include "../content/Segment.hpp"
+#include "../content/Fill.hpp"
+
+#include "Tiles.hpp"
+#include "TileMap.hpp"
+#include "Backdrops.hpp"
+
+namespace pf {
+	static constexpr float FlatteningTolerance = 0.25f;
+
+	// Implements the fast lattice-clipping algorithm from Nehab and Hoppe, "Random-Access Rendering
+	// of General Vector Graphics" 2006.
+	struct Tiler {
+		Tiler(const Outline& _outline, const RectF& _viewBox, FillRule _fillRule = FillRule::Winding, float _tolerance = FlatteningTolerance);
+		// Tiles an outline where it lies in its arena, without copying the contours out.
+		Tiler(const OutlineView& _outline, const RectF& _viewBox, FillRule _fillRule = FillRule::Winding, float _tolerance = FlatteningTolerance);
+
+		void generateTiles();
+
+		// Null when tiling an arena outline, which is then given by view.
+		const Outline* outline;
+		OutlineView view;
+		RectF viewBox;
+		RectI tileBounds;
+		FillRule fillRule;
+		float tolerance;
+
+		// Fills in generation order, linked to the path local alpha tile indices.
+		std::vector<Fill> fills;
+		// One tile per entry of tileBounds.
+		DenseTileMap<TileObjectPrimitive> tiles;
+		// Backdrop deltas while tiling, kept apart from tiles so they can be propagated with SIMD.
+		DenseTileMap<int8_t> tileBackdrops;
+		// Whether each tile is empty, solid or needs a mask, complete after generateTiles.
+		DenseTileMap<TileKind> kinds;
+		// The sum of the backdrops of each tile column above the view box.
+		std::vector<int32_t> backdrops;
+		uint32_t alphaTileCount;
+	private:
+		// Scratch space for flattened curves, reused across segments.
+		std::vector<LineSegment2F> lines;
+
+		Tiler(const Outline* _outline, const OutlineView& _view, const RectF& bounds, const RectF& _viewBox, FillRule _fillRule, float _tolerance);
+
+		template<typename Source>
+		void generateFills(const Source& source);
+		void prepareTiles();
+
+		void processSegment(const Segment& segment);
+		void processLineSegment(const LineSegment2F& segment);
+
+		void addFill(const LineSegment2F& segment, const glm::ivec2& tileCoords);
+		void adjustAlphaTileBackdrop(const glm::ivec2& tileCoords, int8_t delta);
+		uint32_t getOrAllocateAlphaTile(const glm::ivec2& tileCoords);
+	};
+};
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "Tiles.hpp"
+
+namespace pf {
+	bool TileObjectPrimitive::isSolid() const noexcept {
+		return alphaTileId == InvalidAlphaTileId;
+	}
+	bool TileObjectPrimitive::isFilled(FillRule rule) const noexcept {
+		return windingIsInside(backdrop, rule);
+	}
+
+	RectI roundRectOutToTileBounds(const RectF& rect) noexcept {
+		glm::vec2 scale{ 1.f / TileWidth, 1.f / TileHeight };
+		return RectI{ RectF::fromPoints(rect.min() * scale, rect.max() * scale).roundOut() };
+	}
+};
\ No newline at end of file
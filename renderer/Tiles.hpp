@@ -0,0 +1,45 @@
+#pragma once
+#include <cinttypes>
+
+#include "../geometry/Rect.hpp"
+#include "../content/Fill.hpp"
+
+namespace pf {
+	static constexpr int32_t
+		TileWidth = 16,
+		TileHeight = 16;
+
+	static constexpr uint32_t InvalidAlphaTileId = ~0u;
+
+	enum class TileKind : uint8_t {
+		/// Not covered by the path.
+		Empty,
+		/// Fully covered, no mask needed.
+		Solid,
+		/// Crossed by an edge, needs a mask built from its fills.
+		Alpha,
+	};
+
+	// A line segment in 8.8 fixed point, relative to the upper left corner of its tile.
+	struct LineSegmentU16 {
+		uint16_t fromX, fromY, toX, toY;
+	};
+
+	struct Fill {
+		LineSegmentU16 lineSegment;
+		// The alpha tile this fill is accumulated into.
+		uint32_t link;
+	};
+
+	struct TileObjectPrimitive {
+		int16_t tileX, tileY;
+		uint32_t alphaTileId;
+		int8_t backdrop;
+
+		bool isSolid() const noexcept;
+		// Whether a solid tile is filled under the rule, as opposed to empty.
+		bool isFilled(FillRule rule) const noexcept;
+	};
+
+	RectI roundRectOutToTileBounds(const RectF& rect) noexcept;
+};
\ No newline at end of file
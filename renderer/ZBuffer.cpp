@@ -0,0 +1,31 @@
+#include "ZBuffer.hpp"
+
+#include <algorithm>
+
+namespace pf {
+	ZBuffer::ZBuffer(const RectF& viewBox)
+		: buffer(roundRectOutToTileBounds(viewBox), 0)
+	{}
+
+	void ZBuffer::update(const DenseTileMap<TileKind>& kinds, uint32_t depth) noexcept {
+		std::optional<RectI> overlap = kinds.rect.intersection(buffer.rect);
+		if (!overlap) {
+			return;
+		}
+
+		for (int y = overlap->minY(); y < overlap->maxY(); ++y) {
+			const TileKind* kind = kinds.row(y) + (overlap->minX() - kinds.rect.minX());
+			uint32_t* occluder = buffer.row(y) + (overlap->minX() - buffer.rect.minX());
+			for (int x = 0; x < overlap->width(); ++x) {
+				if (kind[x] == TileKind::Solid) {
+					occluder[x] = std::max(occluder[x], depth + 1);
+				}
+			}
+		}
+	}
+
+	bool ZBuffer::test(const glm::ivec2& coords, uint32_t depth) const noexcept {
+		const uint32_t* occluder = buffer.get(coords);
+		return !occluder || *occluder <= depth + 1;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <cinttypes>
+
+#include "../geometry/Rect.hpp"
+
+#include "Tiles.hpp"
+#include "TileMap.hpp"
+
+namespace pf {
+	// Remembers, for each tile of the view box, the frontmost path that covers it with an opaque
+	// solid tile. Paths are identified by their depth, which grows towards the viewer.
+	struct ZBuffer {
+		ZBuffer(const RectF& viewBox);
+
+		// Records the solid tiles of the path at depth as occluders.
+		void update(const DenseTileMap<TileKind>& kinds, uint32_t depth) noexcept;
+
+		// Whether the tile of the path at depth can be seen, that is no occluder lies in front of it.
+		bool test(const glm::ivec2& coords, uint32_t depth) const noexcept;
+
+		// One plus the depth of the frontmost occluder, zero where there is none.
+		DenseTileMap<uint32_t> buffer;
+	};
+};
\ No newline at end of file
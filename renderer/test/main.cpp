@@ -0,0 +1,533 @@
+#include <fmt/core.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "../../simd/Simd.hpp"
+#include "../../color/matrix.hpp"
+#include "../../content/Fill.hpp"
+#include "../../content/Gradient.hpp"
+#include "../../content/Orientation.hpp"
+#include "../../content/ContourSoA.hpp"
+#include "../Backdrops.hpp"
+#include "../Blend.hpp"
+#include "../Rasterizer.hpp"
+
+using namespace pf;
+
+static int failures = 0;
+
+static void check(bool passed, std::string_view what) {
+	if (!passed) {
+		fmt::print("FAILED: {}\n", what);
+		++failures;
+	}
+}
+
+// Runs f once per SIMD level, starting with Scalar. Levels the CPU lacks fall back to the detected
+// one, so the last run leaves the detected level in place.
+template<typename F>
+static auto atEveryLevel(F&& f) {
+	std::vector<decltype(f())> results;
+	for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::NEON }) {
+		limitSimdLevel(level);
+		results.push_back(f());
+	}
+	return results;
+}
+
+template<typename T>
+static bool allEqual(const std::vector<T>& results) {
+	return std::all_of(results.begin(), results.end(), [&](const T& result) { return result == results.front(); });
+}
+
+static Contour polygon(const std::vector<glm::vec2>& points) {
+	Contour contour;
+	for (const glm::vec2& point : points) {
+		contour.pushEndpoint(point);
+	}
+	contour.close();
+	return contour;
+}
+static Contour rect(float minX, float minY, float maxX, float maxY, bool reversed = false) {
+	if (reversed) {
+		return polygon({ { minX, minY }, { minX, maxY }, { maxX, maxY }, { maxX, minY } });
+	}
+	return polygon({ { minX, minY }, { maxX, minY }, { maxX, maxY }, { minX, maxY } });
+}
+
+// Area of the pixel at (x, y) covered by the rect.
+static float pixelOverlap(const RectF& rect, int x, int y) {
+	float width = std::min(rect.maxX(), x + 1.f) - std::max(rect.minX(), static_cast<float>(x));
+	float height = std::min(rect.maxY(), y + 1.f) - std::max(rect.minY(), static_cast<float>(y));
+	return std::max(width, 0.f) * std::max(height, 0.f);
+}
+
+static void testSignedArea() {
+	Contour circle;
+	for (int i = 0; i < 1001; ++i) {
+		float angle = 6.2831853f * i / 1001.f;
+		circle.pushEndpoint({ 500.f + 300.f * std::cos(angle), 500.f + 300.f * std::sin(angle) });
+	}
+	const ContourSoA soa = ContourSoA::fromContour(circle);
+
+	for (std::size_t count : { 3, 4, 5, 9, 17, 1001 }) {
+		Contour contour;
+		for (std::size_t i = 0; i < count; ++i) {
+			contour.pushEndpoint(circle.points[i * (circle.size() / count)].point);
+		}
+		const ContourSoA contourSoA = ContourSoA::fromContour(contour);
+
+		double reference = 0.;
+		for (std::size_t i = 0; i < count; ++i) {
+			const glm::vec2 &u = contour.points[i].point, &v = contour.points[(i + 1) % count].point;
+			reference += static_cast<double>(u.x) * v.y - static_cast<double>(u.y) * v.x;
+		}
+		reference *= 0.5;
+
+		auto areas = atEveryLevel([&] {
+			return std::vector<float>{ signedArea(contour), signedArea(contourSoA) };
+		});
+		for (const std::vector<float>& area : areas) {
+			for (float value : area) {
+				check(std::abs(value - reference) <= 1e-5 * std::abs(reference) + 1e-3, fmt::format("signedArea of {} points is {}, not {}", count, value, reference));
+			}
+		}
+	}
+
+	auto orientations = atEveryLevel([&] {
+		return std::vector<Orientation>{ orientationOf(circle), orientationOf(Outline::fromRect(RectF::fromPoints({ 0.f, 0.f }, { 4.f, 4.f }))) };
+	});
+	check(allEqual(orientations), "orientationOf differs between levels");
+	check(signedArea(soa) > 0.f, "clockwise contour has negative area");
+}
+
+static void testPrefixSum() {
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> delta(-1.f, 1.f);
+
+	for (std::size_t count : { 4, 8, 12, 64, 100, 1028 }) {
+		std::vector<float> input(count);
+		for (float& value : input) {
+			value = delta(random);
+		}
+
+		auto sums = atEveryLevel([&] {
+			std::vector<float> output(count);
+			CoverageAccumulator::prefixSum(input.data(), output.data(), count);
+			return output;
+		});
+		check(allEqual(sums), fmt::format("prefixSum of {} differs between levels", count));
+
+		double sum = 0., worst = 0.;
+		for (std::size_t i = 0; i < count; ++i) {
+			sum += input[i];
+			worst = std::max(worst, std::abs(sum - sums.front()[i]));
+		}
+		check(worst < 1e-4, fmt::format("prefixSum of {} is off by {}", count, worst));
+	}
+}
+
+// Two overlapping rects, the second on whole pixels, so the exact coverage of each rule is known
+// in closed form: a pixel is never cut by the edges of both.
+static void testGoldenCoverage() {
+	constexpr int Size = 32;
+	const RectF first = RectF::fromPoints({ 2.5f, 3.75f }, { 20.25f, 18.5f });
+	const RectF second = RectF::fromPoints({ 10.f, 12.f }, { 30.f, 29.f });
+
+	struct Case {
+		std::string_view name;
+		bool reversed;
+		FillRule rule;
+		// Combines the coverage of the first and second rect of a pixel.
+		float (*combine)(float, float);
+	};
+	const Case cases[] = {
+		{ "union, nonzero", false, FillRule::Winding, [](float a, float b) { return std::max(a, b); } },
+		{ "overlap cut out, even-odd", false, FillRule::EvenOdd, [](float a, float b) { return a + b - 2.f * a * b; } },
+		{ "reversed second rect, nonzero", true, FillRule::Winding, [](float a, float b) { return std::abs(a - b); } },
+		{ "reversed second rect, even-odd", true, FillRule::EvenOdd, [](float a, float b) { return a + b - 2.f * a * b; } },
+	};
+
+	for (const Case& test : cases) {
+		Outline outline;
+		outline.push(rect(first.minX(), first.minY(), first.maxX(), first.maxY()));
+		outline.push(rect(second.minX(), second.minY(), second.maxX(), second.maxY(), test.reversed));
+
+		for (SimdLevel level : { SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::NEON }) {
+			limitSimdLevel(level);
+			SoftwareRasterizer rasterizer{ { Size, Size }, TextureFormat::R8 };
+			rasterizer.fill(outline, ColorU::black(), Transform2F{}, test.rule);
+
+			int worst = 0;
+			const std::vector<uint8_t>& pixels = rasterizer.data.asU8();
+			for (int y = 0; y < Size; ++y) {
+				for (int x = 0; x < Size; ++x) {
+					float coverage = test.combine(pixelOverlap(first, x, y), pixelOverlap(second, x, y));
+					int expected = static_cast<int>(std::lround(coverage * 255.f));
+					worst = std::max(worst, std::abs(expected - pixels[y * Size + x]));
+				}
+			}
+			check(worst <= 1, fmt::format("golden coverage, {} at {}, off by {}", test.name, to_string_view(simdLevel()), worst));
+		}
+	}
+}
+
+// The sparse cells add their deltas straight into the running sum, while the dense rows are summed in
+// blocks, so the coverage can round to a neighbouring byte.
+static void testDenseMatchesSparse() {
+	constexpr int Size = 96;
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> coordinate(-8.f, Size + 8.f);
+
+	for (int iteration = 0; iteration < 20; ++iteration) {
+		std::vector<LineSegment2F> lines;
+		glm::vec2 start{ coordinate(random), coordinate(random) }, from = start;
+		for (int i = 0; i < 24; ++i) {
+			glm::vec2 to = i == 23 ? start : glm::vec2{ coordinate(random), coordinate(random) };
+			lines.push_back(LineSegment2F{ from, to });
+			from = to;
+		}
+
+		for (FillRule rule : { FillRule::Winding, FillRule::EvenOdd }) {
+			CoverageAccumulator dense{ Size, Size };
+			SparseCoverageAccumulator sparse{ Size, Size };
+			for (const LineSegment2F& line : lines) {
+				dense.addLine(line);
+				sparse.addLine(line);
+			}
+
+			std::vector<uint8_t> denseCoverage(Size * Size), sparseCoverage(Size * Size, 0);
+			dense.resolve(rule, denseCoverage.data(), Size);
+			std::vector<CoverageSpan> spans;
+			sparse.resolve(rule, spans);
+			writeSpans(spans, sparseCoverage.data(), Size);
+
+			int worst = 0;
+			for (std::size_t i = 0; i < denseCoverage.size(); ++i) {
+				worst = std::max(worst, std::abs(denseCoverage[i] - sparseCoverage[i]));
+			}
+			check(worst <= 1, fmt::format("dense and sparse coverage of polygon {} differ by {}", iteration, worst));
+		}
+	}
+}
+
+// Reference for propagateBackdrops, one tile at a time on 32 bit windings.
+static void propagateBackdropsReference(DenseTileMap<int8_t>& backdrops, std::vector<int32_t>& columns, FillRule rule, DenseTileMap<TileKind>& kinds) {
+	const std::size_t width = columns.size();
+	for (std::size_t i = 0; i < backdrops.size(); ++i) {
+		int32_t& column = columns[i % width];
+		int32_t winding = column;
+		column += backdrops.data[i];
+		backdrops.data[i] = rule == FillRule::Winding
+			? static_cast<int8_t>(std::clamp(winding, -128, 127))
+			: static_cast<int8_t>(static_cast<uint8_t>(winding & 0xFF));
+		if (kinds.data[i] != TileKind::Alpha) {
+			kinds.data[i] = windingIsInside(winding, rule) ? TileKind::Solid : TileKind::Empty;
+		}
+	}
+}
+
+static void testBackdrops() {
+	std::mt19937 random(3);
+
+	for (int iteration = 0; iteration < 100; ++iteration) {
+		int width = static_cast<int>(random() % 70), height = 1 + static_cast<int>(random() % 9);
+		RectI bounds = RectI::fromPoints({ -2, 1 }, { width - 2, 1 + height });
+		DenseTileMap<int8_t> backdrops{ bounds, 0 };
+		DenseTileMap<TileKind> kinds{ bounds, TileKind::Empty };
+		std::vector<int32_t> columns(static_cast<std::size_t>(width));
+		for (int32_t& column : columns) {
+			column = static_cast<int32_t>(random() % 800) - 400;
+		}
+		for (std::size_t i = 0; i < backdrops.size(); ++i) {
+			backdrops.data[i] = static_cast<int8_t>(static_cast<int>(random() % 7) - 3);
+			kinds.data[i] = random() % 3 == 0 ? TileKind::Alpha : TileKind::Empty;
+		}
+
+		for (FillRule rule : { FillRule::Winding, FillRule::EvenOdd }) {
+			DenseTileMap<int8_t> expectedBackdrops = backdrops;
+			DenseTileMap<TileKind> expectedKinds = kinds;
+			std::vector<int32_t> expectedColumns = columns;
+			propagateBackdropsReference(expectedBackdrops, expectedColumns, rule, expectedKinds);
+
+			auto matches = atEveryLevel([&] {
+				DenseTileMap<int8_t> resultBackdrops = backdrops;
+				DenseTileMap<TileKind> resultKinds = kinds;
+				std::vector<int32_t> resultColumns = columns;
+				propagateBackdrops(resultBackdrops, resultColumns, rule, resultKinds);
+				return resultBackdrops.data == expectedBackdrops.data && resultKinds.data == expectedKinds.data && resultColumns == expectedColumns;
+			});
+			check(std::all_of(matches.begin(), matches.end(), [](bool match) { return match; }),
+				fmt::format("propagateBackdrops differs from the reference, {} columns", width));
+		}
+	}
+}
+
+static void testGradientSpans() {
+	Gradient linear = Gradient::linearFromPoints({ 10.f, 5.f }, { 200.f, 60.f });
+	linear.addColorStop(ColorU{ 255, 0, 0, 255 }, 0.f);
+	linear.addColorStop(ColorU{ 0, 255, 0, 128 }, 0.4f);
+	linear.addColorStop(ColorU{ 0, 0, 255, 255 }, 1.f);
+
+	Gradient radial = Gradient::radial(LineSegment2F{ glm::vec2{ 50.f, 50.f }, glm::vec2{ 120.f, 90.f } }, glm::vec2{ 10.f, 60.f });
+	radial.addColorStop(ColorU{ 255, 0, 0, 255 }, 0.f);
+	radial.addColorStop(ColorU{ 0, 0, 255, 200 }, 1.f);
+	radial.applyTransform(Transform2F::fromRotation(0.3f));
+
+	for (Gradient* gradient : { &linear, &radial }) {
+		for (GradientWrap wrap : { GradientWrap::Clamp, GradientWrap::Repeat }) {
+			gradient->wrap = wrap;
+			const GradientRamp ramp{ *gradient };
+
+			for (std::size_t count : { 1, 7, 33, 203 }) {
+				for (float y : { 0.5f, 47.5f, 90.5f }) {
+					auto spans = atEveryLevel([&] {
+						std::vector<uint8_t> pixels(count * 4);
+						ramp.fillSpan({ -3.5f, y }, count, pixels.data());
+						return pixels;
+					});
+					check(allEqual(spans), fmt::format("gradient span of {} at y {} differs between levels", count, y));
+				}
+			}
+		}
+	}
+}
+
+// Reference of the W3C compositing and blending formulas, in double.
+static double blendChannel(BlendMode mode, double backdrop, double source) {
+	switch (mode) {
+	case BlendMode::Multiply: return backdrop * source;
+	case BlendMode::Screen: return backdrop + source - backdrop * source;
+	case BlendMode::Overlay: return blendChannel(BlendMode::HardLight, source, backdrop);
+	case BlendMode::Darken: return std::min(backdrop, source);
+	case BlendMode::Lighten: return std::max(backdrop, source);
+	case BlendMode::ColorDodge:
+		if (backdrop == 0.) {
+			return 0.;
+		}
+		return source >= 1. ? 1. : std::min(1., backdrop / (1. - source));
+	case BlendMode::ColorBurn:
+		if (backdrop >= 1.) {
+			return 1.;
+		}
+		return source == 0. ? 0. : 1. - std::min(1., (1. - backdrop) / source);
+	case BlendMode::HardLight: return source <= 0.5 ? 2. * backdrop * source : blendChannel(BlendMode::Screen, backdrop, 2. * source - 1.);
+	case BlendMode::SoftLight: {
+		double d = backdrop <= 0.25 ? ((16. * backdrop - 12.) * backdrop + 4.) * backdrop : std::sqrt(backdrop);
+		return source <= 0.5 ? backdrop - (1. - 2. * source) * backdrop * (1. - backdrop) : backdrop + (2. * source - 1.) * (d - backdrop);
+	}
+	case BlendMode::Difference: return std::abs(backdrop - source);
+	case BlendMode::Exclusion: return backdrop + source - 2. * backdrop * source;
+	default: return 0.;
+	}
+}
+
+struct Rgb {
+	double r, g, b;
+};
+static double lum(const Rgb& c) {
+	return 0.3 * c.r + 0.59 * c.g + 0.11 * c.b;
+}
+static double sat(const Rgb& c) {
+	return std::max({ c.r, c.g, c.b }) - std::min({ c.r, c.g, c.b });
+}
+static Rgb clipColor(const Rgb& c) {
+	double l = lum(c), n = std::min({ c.r, c.g, c.b }), x = std::max({ c.r, c.g, c.b });
+	auto clip = [&](double channel) {
+		if (n < 0.) {
+			channel = l + (channel - l) * l / (l - n);
+		}
+		if (x > 1.) {
+			channel = l + (channel - l) * (1. - l) / (x - l);
+		}
+		return channel;
+	};
+	return Rgb{ clip(c.r), clip(c.g), clip(c.b) };
+}
+static Rgb setLum(const Rgb& c, double l) {
+	double d = l - lum(c);
+	return clipColor(Rgb{ c.r + d, c.g + d, c.b + d });
+}
+static Rgb setSat(const Rgb& c, double s) {
+	double n = std::min({ c.r, c.g, c.b }), x = std::max({ c.r, c.g, c.b });
+	auto scale = [&](double channel) { return x > n ? (channel - n) * s / (x - n) : 0.; };
+	return Rgb{ scale(c.r), scale(c.g), scale(c.b) };
+}
+static Rgb blendColor(BlendMode mode, const Rgb& backdrop, const Rgb& source) {
+	switch (mode) {
+	case BlendMode::Hue: return setLum(setSat(source, sat(backdrop)), lum(backdrop));
+	case BlendMode::Saturation: return setLum(setSat(backdrop, sat(source)), lum(backdrop));
+	case BlendMode::Color: return setLum(source, lum(backdrop));
+	case BlendMode::Luminosity: return setLum(backdrop, lum(source));
+	default: return Rgb{ blendChannel(mode, backdrop.r, source.r), blendChannel(mode, backdrop.g, source.g), blendChannel(mode, backdrop.b, source.b) };
+	}
+}
+
+// Blends one premultiplied RGBA pixel, clamped to [0, 1].
+static void blendReference(BlendMode mode, const double* s, const double* d, double* result) {
+	if (mode <= BlendMode::Lighter) {
+		double sourceFactor = 1., destinationFactor = 1.;
+		switch (mode) {
+		case BlendMode::Clear: sourceFactor = 0.; destinationFactor = 0.; break;
+		case BlendMode::Copy: destinationFactor = 0.; break;
+		case BlendMode::SrcIn: sourceFactor = d[3]; destinationFactor = 0.; break;
+		case BlendMode::SrcOut: sourceFactor = 1. - d[3]; destinationFactor = 0.; break;
+		case BlendMode::SrcOver: destinationFactor = 1. - s[3]; break;
+		case BlendMode::SrcAtop: sourceFactor = d[3]; destinationFactor = 1. - s[3]; break;
+		case BlendMode::DestIn: sourceFactor = 0.; destinationFactor = s[3]; break;
+		case BlendMode::DestOut: sourceFactor = 0.; destinationFactor = 1. - s[3]; break;
+		case BlendMode::DestOver: sourceFactor = 1. - d[3]; break;
+		case BlendMode::DestAtop: sourceFactor = 1. - d[3]; destinationFactor = s[3]; break;
+		case BlendMode::Xor: sourceFactor = 1. - d[3]; destinationFactor = 1. - s[3]; break;
+		default: break;
+		}
+		for (int c = 0; c < 4; ++c) {
+			result[c] = s[c] * sourceFactor + d[c] * destinationFactor;
+		}
+	}
+	else {
+		// Unpremultiplied, with transparent pixels black.
+		auto unpremultiply = [](const double* p) {
+			return p[3] > 0. ? Rgb{ p[0] / p[3], p[1] / p[3], p[2] / p[3] } : Rgb{ 0., 0., 0. };
+		};
+		Rgb mixed = blendColor(mode, unpremultiply(d), unpremultiply(s));
+		const double channels[3] = { mixed.r, mixed.g, mixed.b };
+		for (int c = 0; c < 3; ++c) {
+			result[c] = s[c] * (1. - d[3]) + d[c] * (1. - s[3]) + s[3] * d[3] * channels[c];
+		}
+		result[3] = s[3] + d[3] - s[3] * d[3];
+	}
+
+	for (int c = 0; c < 4; ++c) {
+		result[c] = std::clamp(result[c], 0., 1.);
+	}
+}
+
+// The blend lanes are picked at compile time, so the spans are compared with the reference instead of
+// across levels. The count leaves a partial group for the zero padded tail.
+static void testBlendSpans() {
+	constexpr std::size_t Count = 1003;
+	std::mt19937 random(5);
+	std::vector<uint8_t> source(Count * 4), destination(Count * 4);
+	for (std::size_t i = 0; i < Count; ++i) {
+		uint8_t sourceAlpha = i % 7 == 0 ? 255 : i % 11 == 0 ? 0 : static_cast<uint8_t>(random() % 256);
+		uint8_t destinationAlpha = i % 5 == 0 ? 255 : i % 13 == 0 ? 0 : static_cast<uint8_t>(random() % 256);
+		for (int c = 0; c < 3; ++c) {
+			source[4 * i + c] = static_cast<uint8_t>(random() % (sourceAlpha + 1u));
+			destination[4 * i + c] = static_cast<uint8_t>(random() % (destinationAlpha + 1u));
+		}
+		source[4 * i + 3] = sourceAlpha;
+		destination[4 * i + 3] = destinationAlpha;
+	}
+
+	std::vector<half> sourceHalf(Count * 4), destinationHalf(Count * 4);
+	for (std::size_t i = 0; i < Count * 4; ++i) {
+		sourceHalf[i] = half{ source[i] / 255.f };
+		destinationHalf[i] = half{ destination[i] / 255.f };
+	}
+
+	for (int m = 0; m <= static_cast<int>(BlendMode::Luminosity); ++m) {
+		const BlendMode mode = static_cast<BlendMode>(m);
+
+		std::vector<uint8_t> output = destination;
+		blendSpan(mode, source.data(), output.data(), Count);
+		std::vector<half> outputHalf = destinationHalf;
+		blendSpan(mode, sourceHalf.data(), outputHalf.data(), Count);
+
+		int worst = 0;
+		double worstHalf = 0.;
+		for (std::size_t i = 0; i < Count; ++i) {
+			double s[4], d[4], expected[4];
+			for (int c = 0; c < 4; ++c) {
+				s[c] = source[4 * i + c] / 255.;
+				d[c] = destination[4 * i + c] / 255.;
+			}
+			blendReference(mode, s, d, expected);
+			for (int c = 0; c < 4; ++c) {
+				worst = std::max(worst, std::abs(static_cast<int>(std::lround(expected[c] * 255.)) - output[4 * i + c]));
+			}
+
+			// The half inputs are rounded, so the reference starts from the same values.
+			for (int c = 0; c < 4; ++c) {
+				s[c] = static_cast<float>(sourceHalf[4 * i + c]);
+				d[c] = static_cast<float>(destinationHalf[4 * i + c]);
+			}
+			blendReference(mode, s, d, expected);
+			for (int c = 0; c < 4; ++c) {
+				worstHalf = std::max(worstHalf, std::abs(expected[c] - static_cast<float>(outputHalf[4 * i + c])));
+			}
+		}
+		check(worst <= 1, fmt::format("blend mode {} on RGBA8 is off by {}", m, worst));
+		// Half an ulp of a half just below 1 is 2.4e-4.
+		check(worstHalf <= 5e-4, fmt::format("blend mode {} on RGBA16F is off by {}", m, worstHalf));
+	}
+}
+
+static void testColorMatrix() {
+	constexpr std::size_t Count = 1003;
+	std::mt19937 random(9);
+	std::vector<ColorU> colors(Count);
+	for (ColorU& color : colors) {
+		color = ColorU(random() % 256, random() % 256, random() % 256, random() % 256);
+	}
+
+	const ColorMatrix matrices[] = {
+		ColorMatrix::hue_rotate(1.1f),
+		ColorMatrix::saturate(0.3f),
+		ColorMatrix::luminance_to_alpha(),
+		ColorMatrix::from_rows({ 1.f, 0.f, 0.f, 0.f, 0.2f }, { 0.f, -1.f, 0.f, 0.f, 1.f }, { 0.f, 0.f, 1.f, 0.f, -0.1f }, { 0.f, 0.f, 0.f, 0.5f, 0.25f }),
+		// Out of the fixed point range, so the bytes go through floats.
+		ColorMatrix::saturate(20.f),
+	};
+	for (std::size_t m = 0; m < std::size(matrices); ++m) {
+		const ColorMatrix& matrix = matrices[m];
+
+		auto bytes = atEveryLevel([&] {
+			std::vector<ColorU> result = colors;
+			matrix.apply(result.data(), result.size());
+			return result;
+		});
+		check(allEqual(bytes), fmt::format("color matrix {} on bytes differs between levels", m));
+
+		auto floats = atEveryLevel([&] {
+			std::vector<ColorF> result(Count);
+			for (std::size_t i = 0; i < Count; ++i) {
+				result[i] = colors[i].to_f32();
+			}
+			matrix.apply(result.data(), result.size());
+			return result;
+		});
+		float worst = 0.f;
+		for (const std::vector<ColorF>& result : floats) {
+			for (std::size_t i = 0; i < Count; ++i) {
+				glm::vec4 expected = matrix.apply(glm::vec4{ colors[i].to_f32() });
+				for (int c = 0; c < 4; ++c) {
+					worst = std::max(worst, std::abs(expected[c] - result[i][c]));
+				}
+			}
+		}
+		check(worst <= 1e-5f, fmt::format("color matrix {} on floats is off by {}", m, worst));
+	}
+}
+
+int main() {
+	testSignedArea();
+	testPrefixSum();
+	testGoldenCoverage();
+	testDenseMatchesSparse();
+	testBackdrops();
+	testGradientSpans();
+	testBlendSpans();
+	testColorMatrix();
+
+	if (failures > 0) {
+		fmt::print("{} checks failed\n", failures);
+		return 1;
+	}
+	fmt::print("All checks passed\n");
+	return 0;
+}
\ No newline at end of file
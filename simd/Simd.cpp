@@ -0,0 +1,76 @@
+#include "Simd.hpp"
+
+#include <atomic>
+
+#if defined(PF_SIMD_SSE2) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace pf {
+	static SimdLevel detectSimdLevel() noexcept {
+#if defined(PF_SIMD_SSE2)
+	#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] >= 7) {
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			__cpuidex(info, 7, 0);
+			bool avx2 = (info[1] & (1 << 5)) != 0;
+			// The OS has to save the upper halves of the ymm registers too.
+			if (osxsave && avx && avx2 && (_xgetbv(0) & 0x6) == 0x6) {
+				return SimdLevel::AVX2;
+			}
+		}
+	#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) {
+			return SimdLevel::AVX2;
+		}
+	#endif
+		return SimdLevel::SSE2;
+#elif defined(PF_SIMD_NEON)
+		return SimdLevel::NEON;
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	// Function local so kernels running during static initialization still see a detected level.
+	static SimdLevel detectedLevel() noexcept {
+		static const SimdLevel level = detectSimdLevel();
+		return level;
+	}
+	static std::atomic<SimdLevel>& currentLevel() noexcept {
+		static std::atomic<SimdLevel> level{ detectedLevel() };
+		return level;
+	}
+
+	SimdLevel simdLevel() noexcept {
+		return currentLevel().load(std::memory_order_relaxed);
+	}
+
+	void limitSimdLevel(SimdLevel level) noexcept {
+		SimdLevel detected = detectedLevel();
+		bool supported = level == SimdLevel::Scalar || level == detected
+			|| (detected == SimdLevel::AVX2 && level == SimdLevel::SSE2);
+
+		currentLevel().store(supported ? level : detected, std::memory_order_relaxed);
+	}
+
+	std::string_view to_string_view(SimdLevel level) noexcept {
+		switch (level) {
+		case SimdLevel::Scalar:
+			return "Scalar";
+		case SimdLevel::SSE2:
+			return "SSE2";
+		case SimdLevel::AVX2:
+			return "AVX2";
+		case SimdLevel::NEON:
+			return "NEON";
+		default:
+			return "Unknown";
+		}
+	}
+};
\ No newline at end of file
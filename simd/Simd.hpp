@@ -0,0 +1,38 @@
+#pragma once
+#include <cinttypes>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PF_SIMD_SSE2 1
+	#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define PF_SIMD_NEON 1
+	#include <arm_neon.h>
+#endif
+
+// Marks a function as compiled for AVX2, so it can live next to baseline code and be picked at
+// runtime. MSVC accepts AVX2 intrinsics anywhere, so it needs no attribute.
+#if defined(PF_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+	#define PF_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define PF_TARGET_AVX2
+#endif
+
+namespace pf {
+	enum class SimdLevel {
+		Scalar,
+		SSE2,
+		AVX2,
+		NEON,
+	};
+
+	// The widest instruction set that is both compiled in and supported by the running CPU.
+	// Detected once, then cached.
+	SimdLevel simdLevel() noexcept;
+
+	// Caps the level returned by simdLevel(), for comparing kernels against the scalar fallbacks.
+	// Levels above what the CPU supports are ignored.
+	void limitSimdLevel(SimdLevel level) noexcept;
+
+	std::string_view to_string_view(SimdLevel level) noexcept;
+};
\ No newline at end of file